@@ -0,0 +1,561 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : ChatServer.hpp
+ * Description : One chat server assembled from compile-time policies for
+                 I/O, framing and concurrency
+ ****************************************************/
+
+#pragma once
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ContentFilter.hpp"
+#include "ThreadPlacement.hpp"
+#include "TimingWheel.hpp"
+
+#pragma comment(lib, "ws2_32.lib")
+
+// ChatServer<IoBackend, Framing, Concurrency, Session> holds the connection
+// bookkeeping once; the policies decide how bytes move and what a line
+// does. They are template parameters, so every call below is resolved at
+// compile time and nothing on the per-message path is virtual.
+//
+//   IoBackend    void run(Server&, SOCKET listener)
+//                void send(SOCKET, std::string_view)
+//   Framing      static void decode(std::string& buffer, std::string_view data, Emit emit)
+//                static std::string encode(std::string_view message)
+//   Concurrency  using Mutex = ...;  void dispatch(SOCKET, Task) runs a connection's read loop
+//                bool acceptsMore() const; explicit Concurrency(std::vector<int> cores)
+//   Session      static constexpr bool login, retry_empty_name
+//                static std::string welcome(const std::string& username)
+//                static void message(username, line, Reply reply, Broadcast broadcast)
+namespace ChatPolicy {
+    // Framing
+
+    // Newline-terminated lines, CR stripped and sanitised; a line longer
+    // than MAX_LINE is cut there rather than buffered without bound
+    struct LineFraming {
+        static constexpr std::size_t MAX_LINE = 4096;
+
+        template <typename Emit>
+        static void decode(std::string& buffer, std::string_view data, Emit&& emit) {
+            buffer.append(data);
+            std::size_t start = 0, newline;
+            while ((newline = buffer.find('\n', start)) != std::string::npos) {
+                emit(ContentFilter::sanitize(std::string_view(buffer).substr(start, newline - start)));
+                start = newline + 1;
+            }
+            buffer.erase(0, start);
+            if (buffer.size() > MAX_LINE) {
+                emit(ContentFilter::sanitize(buffer));
+                buffer.clear();
+            }
+        }
+
+        static std::string encode(std::string_view message) {
+            std::string framed;
+            framed.reserve(message.size() + 1);
+            framed.append(message);
+            framed += '\n';
+            return framed;
+        }
+    };
+
+    // Every read is one message, as in the client authentication server;
+    // cheapest, but relies on the client sending one line per segment
+    struct ChunkFraming {
+        template <typename Emit>
+        static void decode(std::string&, std::string_view data, Emit&& emit) {
+            emit(ContentFilter::sanitize(data));
+        }
+
+        static std::string encode(std::string_view message) {
+            return LineFraming::encode(message);
+        }
+    };
+
+    // Concurrency
+
+    struct NullMutex {
+        void lock() {}
+        void unlock() {}
+    };
+
+    // Serves a connection on the accepting thread: with blocking I/O that
+    // is one client at a time, with select it is the event loop itself
+    struct Sequential {
+        using Mutex = NullMutex;
+
+        explicit Sequential(std::vector<int> = {}) {}
+
+        template <typename Task>
+        void dispatch(SOCKET, Task&& task) { task(); }
+        bool acceptsMore() const { return true; }
+    };
+
+    // Serves the first connection on the accepting thread, then stops
+    // accepting, as the phase 2 TcpServer does
+    struct SingleConnection {
+        using Mutex = NullMutex;
+
+        explicit SingleConnection(std::vector<int> = {}) {}
+
+        template <typename Task>
+        void dispatch(SOCKET, Task&& task) {
+            served = true;
+            task();
+        }
+        bool acceptsMore() const { return !served; }
+
+    private:
+        bool served = false;
+    };
+
+    // One thread per connection, placed next to the connection's RSS queue
+    struct ThreadPerConnection {
+        using Mutex = std::mutex;
+
+        explicit ThreadPerConnection(std::vector<int> cores = {}) : placement(std::move(cores)) {}
+
+        template <typename Task>
+        void dispatch(SOCKET socket, Task&& task) {
+            int core = placement.steer(socket);
+            try {
+                std::thread([core, task = std::forward<Task>(task)]() mutable {
+                    ThreadPlacement::pinCurrentThread(core);
+                    task();
+                }).detach();
+            }
+            catch (const std::system_error& e) {
+                std::cerr << "Thread creation failed: " << e.what() << std::endl;
+                closesocket(socket);
+            }
+        }
+        bool acceptsMore() const { return true; }
+
+    private:
+        ThreadPlacement placement;
+    };
+
+    // I/O
+
+    // Sends until everything is out; a short write is retried, not lost
+    inline void sendAll(SOCKET socket, std::string_view data) {
+        while (!data.empty()) {
+            int sent = ::send(socket, data.data(), static_cast<int>(data.size()), 0);
+            if (sent <= 0) return;
+            data.remove_prefix(static_cast<std::size_t>(sent));
+        }
+    }
+
+    // Blocking accept, then a blocking read loop per connection, run
+    // wherever the concurrency policy puts it
+    struct BlockingIo {
+        template <typename Server>
+        void run(Server& server, SOCKET listener) {
+            while (server.acceptsMore()) {
+                SOCKET socket = accept(listener, nullptr, nullptr);
+                if (socket == INVALID_SOCKET) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    continue;
+                }
+                server.dispatch(socket, [&server, socket] {
+                    char buffer[4096];
+                    server.open(socket);
+                    int len;
+                    while ((len = recv(socket, buffer, sizeof(buffer), 0)) > 0)
+                        server.receive(socket, std::string_view(buffer, static_cast<std::size_t>(len)));
+                    server.close(socket);
+                });
+            }
+        }
+
+        void send(SOCKET socket, std::string_view data) { sendAll(socket, data); }
+    };
+
+    // One thread multiplexing every connection with select(), with the
+    // phase 4 SelectServer's timers: a username within AUTH_TIMEOUT, then a
+    // line at least every IDLE_TIMEOUT, checked on a TICK-driven wheel.
+    // Sockets are non-blocking both ways. What a client cannot take yet
+    // waits in its outbox until select reports it writable; a client more
+    // than MAX_PENDING behind is dropped instead of stalling the loop.
+    // Winsock's fd_set holds FD_SETSIZE sockets; connections beyond that
+    // are turned away. Everything here runs on the event-loop thread.
+    class SelectIo {
+    public:
+        static constexpr std::chrono::milliseconds TICK{ 100 };
+        static constexpr std::chrono::seconds AUTH_TIMEOUT{ 30 };
+        static constexpr std::chrono::seconds IDLE_TIMEOUT{ 600 };
+        static constexpr std::size_t MAX_PENDING = 1 << 20;
+
+        template <typename Server>
+        void run(Server& server, SOCKET listener) {
+            u_long non_blocking = 1;
+            ioctlsocket(listener, FIONBIO, &non_blocking);
+            std::vector<TimingWheel::Callback> expired;
+            char buffer[4096];
+
+            while (true) {
+                fd_set read_set, write_set;
+                FD_ZERO(&read_set);
+                FD_ZERO(&write_set);
+                FD_SET(listener, &read_set);
+                for (const auto& [socket, peer] : peers) {
+                    FD_SET(socket, &read_set);
+                    if (!peer.outbox.empty()) FD_SET(socket, &write_set);
+                }
+                // Wake at least once per tick so the timers keep moving
+                timeval timeout{ 0, static_cast<long>(TICK.count() * 1000) };
+                int ready = select(0, &read_set, &write_set, nullptr, &timeout);
+
+                timers.advance(TimingWheel::Clock::now(), expired);
+                for (auto& callback : expired) callback();
+                expired.clear();
+
+                if (ready > 0) {
+                    // New sockets are not in this round's sets, so adding
+                    // them before the sweep below is safe
+                    if (FD_ISSET(listener, &read_set)) acceptAll(server, listener);
+                    for (auto& [socket, peer] : peers) {
+                        if (FD_ISSET(socket, &write_set)) flush(socket, peer);
+                        if (peer.doomed || !FD_ISSET(socket, &read_set)) continue;
+                        int len = recv(socket, buffer, sizeof(buffer), 0);
+                        if (len > 0) {
+                            peer.last_read = TimingWheel::Clock::now();
+                            server.receive(socket, std::string_view(buffer, static_cast<std::size_t>(len)));
+                        }
+                        else if (len == 0 || WSAGetLastError() != WSAEWOULDBLOCK) {
+                            peer.doomed = true;
+                        }
+                    }
+                }
+                dropDoomed(server);
+            }
+        }
+
+        // Writes what the socket takes now and queues the rest
+        void send(SOCKET socket, std::string_view data) {
+            auto it = peers.find(socket);
+            if (it == peers.end() || it->second.doomed) return;
+            Peer& peer = it->second;
+            if (peer.outbox.empty()) {
+                int sent = ::send(socket, data.data(), static_cast<int>(data.size()), 0);
+                if (sent > 0) data.remove_prefix(static_cast<std::size_t>(sent));
+                else if (sent < 0 && WSAGetLastError() != WSAEWOULDBLOCK) {
+                    peer.doomed = true;
+                    return;
+                }
+            }
+            if (peer.outbox.size() + data.size() > MAX_PENDING) peer.doomed = true;
+            else peer.outbox.append(data);
+        }
+
+    private:
+        struct Peer {
+            std::string outbox;
+            TimingWheel::Clock::time_point last_read;
+            TimingWheel::TimerId timer = TimingWheel::INVALID_TIMER;
+            bool doomed = false;    // closed at the end of this loop iteration
+        };
+
+        std::unordered_map<SOCKET, Peer> peers;
+        TimingWheel timers{ TICK };
+
+        template <typename Server>
+        void acceptAll(Server& server, SOCKET listener) {
+            SOCKET socket;
+            while ((socket = accept(listener, nullptr, nullptr)) != INVALID_SOCKET) {
+                if (peers.size() + 1 >= FD_SETSIZE) {
+                    closesocket(socket);
+                    continue;
+                }
+                u_long non_blocking = 1;
+                ioctlsocket(socket, FIONBIO, &non_blocking);
+                Peer& peer = peers[socket];
+                peer.last_read = TimingWheel::Clock::now();
+                arm(server, socket, AUTH_TIMEOUT);
+                server.dispatch(socket, [&server, socket] { server.open(socket); });
+            }
+        }
+
+        // One timer per client: before login it is the auth deadline, after
+        // it the idle check, which re-arms itself for the time remaining
+        template <typename Server>
+        void arm(Server& server, SOCKET socket, std::chrono::milliseconds delay) {
+            peers[socket].timer = timers.schedule(delay, [this, &server, socket] {
+                auto it = peers.find(socket);
+                if (it == peers.end()) return;
+                it->second.timer = TimingWheel::INVALID_TIMER;
+                if (!server.loggedIn(socket)) {
+                    server.notify(socket, "Authentication timed out");
+                    it->second.doomed = true;
+                    return;
+                }
+                auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    TimingWheel::Clock::now() - it->second.last_read);
+                if (idle < IDLE_TIMEOUT) {
+                    arm(server, socket, IDLE_TIMEOUT - idle);
+                    return;
+                }
+                server.notify(socket, "Disconnected: idle timeout");
+                it->second.doomed = true;
+            });
+        }
+
+        void flush(SOCKET socket, Peer& peer) {
+            int sent = ::send(socket, peer.outbox.data(), static_cast<int>(peer.outbox.size()), 0);
+            if (sent > 0) peer.outbox.erase(0, static_cast<std::size_t>(sent));
+            else if (sent < 0 && WSAGetLastError() != WSAEWOULDBLOCK) peer.doomed = true;
+        }
+
+        template <typename Server>
+        void dropDoomed(Server& server) {
+            for (auto it = peers.begin(); it != peers.end();) {
+                if (!it->second.doomed) {
+                    ++it;
+                    continue;
+                }
+                timers.cancel(it->second.timer);
+                SOCKET socket = it->first;
+                it = peers.erase(it);
+                server.close(socket);
+            }
+        }
+    };
+
+    // Session
+
+    // Every line straight back, no login (phase 2 TcpServer)
+    struct EchoSession {
+        static constexpr bool login = false;
+        static constexpr bool retry_empty_name = false;
+
+        static std::string welcome(const std::string&) { return ""; }
+
+        template <typename Reply, typename Broadcast>
+        static void message(const std::string&, std::string line, Reply&& reply, Broadcast&&) {
+            reply(std::move(line));
+        }
+    };
+
+    // A username, then "You said: <line>" for every line; an empty name
+    // ends the connection (phase 3 TcpMultiServer)
+    struct AcknowledgeSession {
+        static constexpr bool login = true;
+        static constexpr bool retry_empty_name = false;
+
+        static std::string welcome(const std::string&) { return ""; }
+
+        template <typename Reply, typename Broadcast>
+        static void message(const std::string&, const std::string& line, Reply&& reply, Broadcast&&) {
+            reply("You said: " + line);
+        }
+    };
+
+    // A username and a welcome, then every line goes to the other
+    // logged-in clients as "<name>: <line>" (phase 4 SelectServer)
+    struct BroadcastSession {
+        static constexpr bool login = true;
+        static constexpr bool retry_empty_name = true;
+
+        static std::string welcome(const std::string& username) { return "Welcome, " + username + "!"; }
+
+        template <typename Reply, typename Broadcast>
+        static void message(const std::string& username, const std::string& line, Reply&&, Broadcast&& broadcast) {
+            broadcast(username + ": " + line);
+        }
+    };
+}
+
+template <typename IoBackend, typename Framing, typename Concurrency, typename Session>
+class ChatServer {
+public:
+    // cores: optional CPUs for connection threads (ThreadPerConnection only)
+    explicit ChatServer(int port, std::vector<int> cores = {})
+        : port(port), concurrency(std::move(cores)) {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) throw std::runtime_error("WSAStartup failed");
+    }
+
+    ~ChatServer() {
+        if (listener != INVALID_SOCKET) closesocket(listener);
+        WSACleanup();
+    }
+
+    ChatServer(const ChatServer&) = delete;
+    ChatServer& operator=(const ChatServer&) = delete;
+
+    void start() {
+        setupSocket();
+        io.run(*this, listener);
+    }
+
+    // Called by the I/O backend, at most one call at a time per socket
+    template <typename Task>
+    void dispatch(SOCKET socket, Task&& task) { concurrency.dispatch(socket, std::forward<Task>(task)); }
+    bool acceptsMore() const { return concurrency.acceptsMore(); }
+
+    void open(SOCKET socket) {
+        auto connection = std::make_shared<Connection>(socket);
+        {
+            std::lock_guard<Mutex> lock(mutex);
+            connections[socket] = connection;
+        }
+        if constexpr (Session::login) write(*connection, Framing::encode("Enter your username:"));
+    }
+
+    void receive(SOCKET socket, std::string_view data) {
+        std::shared_ptr<Connection> connection = find(socket);
+        if (!connection) return;
+        // The buffer belongs to the one thread reading this socket
+        Framing::decode(connection->buffer, data, [&](std::string line) { handleLine(connection, std::move(line)); });
+    }
+
+    // The socket itself is closed once the last sender lets go of it
+    void close(SOCKET socket) {
+        std::lock_guard<Mutex> lock(mutex);
+        connections.erase(socket);
+    }
+
+    // For backends that enforce login and idle deadlines
+    bool loggedIn(SOCKET socket) {
+        std::lock_guard<Mutex> lock(mutex);
+        auto it = connections.find(socket);
+        return it != connections.end() && (!Session::login || !it->second->username.empty());
+    }
+
+    void notify(SOCKET socket, std::string_view text) {
+        if (std::shared_ptr<Connection> connection = find(socket)) write(*connection, Framing::encode(text));
+    }
+
+private:
+    using Mutex = typename Concurrency::Mutex;
+
+    struct Connection {
+        SOCKET socket;
+        std::string buffer;
+        std::string username;   // guarded by the server mutex
+        Mutex write_mutex;      // keeps concurrent broadcasts from interleaving
+
+        explicit Connection(SOCKET socket) : socket(socket) {}
+        ~Connection() { closesocket(socket); }
+    };
+
+    int port;
+    SOCKET listener = INVALID_SOCKET;
+    IoBackend io;
+    Concurrency concurrency;
+    Mutex mutex;
+    std::unordered_map<SOCKET, std::shared_ptr<Connection>> connections;
+
+    void setupSocket() {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        if (listener == INVALID_SOCKET) throw std::runtime_error("Socket creation failed");
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = INADDR_ANY;
+        addr.sin_port = htons(static_cast<u_short>(port));
+        int opt = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
+        if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR)
+            throw std::runtime_error("Bind failed: " + std::to_string(WSAGetLastError()));
+        if (listen(listener, SOMAXCONN) == SOCKET_ERROR)
+            throw std::runtime_error("Listen failed: " + std::to_string(WSAGetLastError()));
+        std::cout << "Server listening on port " << port << "...\n";
+    }
+
+    std::shared_ptr<Connection> find(SOCKET socket) {
+        std::lock_guard<Mutex> lock(mutex);
+        auto it = connections.find(socket);
+        return it == connections.end() ? nullptr : it->second;
+    }
+
+    void write(Connection& connection, std::string_view data) {
+        std::lock_guard<Mutex> lock(connection.write_mutex);
+        io.send(connection.socket, data);
+    }
+
+    void handleLine(const std::shared_ptr<Connection>& connection, std::string line) {
+        std::string username;
+        if constexpr (Session::login) {
+            {
+                std::lock_guard<Mutex> lock(mutex);
+                if (connection->username.empty()) connection->username = line;
+                else username = connection->username;
+            }
+            if (username.empty()) {
+                login(*connection, line);
+                return;
+            }
+        }
+        Session::message(username, std::move(line),
+            [&](const std::string& reply) { write(*connection, Framing::encode(reply)); },
+            [&](const std::string& message) { broadcast(Framing::encode(message), connection->socket); });
+    }
+
+    void login(Connection& connection, const std::string& username) {
+        if (!username.empty()) {
+            std::string welcome = Session::welcome(username);
+            if (!welcome.empty()) write(connection, Framing::encode(welcome));
+        }
+        else if (Session::retry_empty_name) {
+            write(connection, Framing::encode("Enter your username:"));
+        }
+        else {
+            // The backend sees the connection end and closes it as usual
+            shutdown(connection.socket, SD_BOTH);
+        }
+    }
+
+    // Recipients are collected under the lock and written to outside it,
+    // so one slow reader never holds up the server mutex
+    void broadcast(const std::string& framed, SOCKET sender) {
+        std::vector<std::shared_ptr<Connection>> recipients;
+        {
+            std::lock_guard<Mutex> lock(mutex);
+            recipients.reserve(connections.size());
+            for (const auto& [socket, connection] : connections) {
+                if (socket != sender && !connection->username.empty()) recipients.push_back(connection);
+            }
+        }
+        for (const auto& recipient : recipients) write(*recipient, framed);
+    }
+};
+
+// One instantiation per phase 2-4 server they replaced, reproducing what its clients saw
+using SingleClientChatServer = ChatServer<ChatPolicy::BlockingIo, ChatPolicy::LineFraming,
+    ChatPolicy::SingleConnection, ChatPolicy::EchoSession>;                                     // TcpServer
+using ThreadedChatServer = ChatServer<ChatPolicy::BlockingIo, ChatPolicy::LineFraming,
+    ChatPolicy::ThreadPerConnection, ChatPolicy::AcknowledgeSession>;                           // TcpMultiServer
+using SelectChatServer = ChatServer<ChatPolicy::SelectIo, ChatPolicy::LineFraming,
+    ChatPolicy::Sequential, ChatPolicy::BroadcastSession>;                                      // SelectServer
+// The client authentication server's I/O model (a thread per client, a
+// message per read) with broadcast chat; its rooms, login and the rest are
+// not on the template
+using ChunkedChatServer = ChatServer<ChatPolicy::BlockingIo, ChatPolicy::ChunkFraming,
+    ChatPolicy::ThreadPerConnection, ChatPolicy::BroadcastSession>;
+
+// Compiled once, in src/ChatServer.cpp
+extern template class ChatServer<ChatPolicy::BlockingIo, ChatPolicy::LineFraming,
+    ChatPolicy::SingleConnection, ChatPolicy::EchoSession>;
+extern template class ChatServer<ChatPolicy::BlockingIo, ChatPolicy::LineFraming,
+    ChatPolicy::ThreadPerConnection, ChatPolicy::AcknowledgeSession>;
+extern template class ChatServer<ChatPolicy::SelectIo, ChatPolicy::LineFraming,
+    ChatPolicy::Sequential, ChatPolicy::BroadcastSession>;
+extern template class ChatServer<ChatPolicy::BlockingIo, ChatPolicy::ChunkFraming,
+    ChatPolicy::ThreadPerConnection, ChatPolicy::BroadcastSession>;
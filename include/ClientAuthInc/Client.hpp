@@ -7,27 +7,87 @@ using SocketType = SOCKET;
 #else
 #include <unistd.h>
 #define INVALID_SOCKET -1
-#define CLOSESOCKET close
+#define CLOSESOCKET ::close
 using SocketType = int;
 #endif
 
 #include <string>
 #include <queue>
+#include <set>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../TimingWheel.hpp"
+#include "compression.hpp"
+#include "flood_control.hpp"
+
+// One queued line. For compressing clients a room message may come with
+// its shared frame, or marked to be sent stored (see Compression).
+struct OutboundMessage {
+    std::string text;
+    std::shared_ptr<const std::string> frame;
+    bool compress = true;
+    std::shared_ptr<Compression::RoomStats> room_stats;  // set for room messages to compressing members
+
+    OutboundMessage(const char* text) : text(text) {}
+    OutboundMessage(std::string text) : text(std::move(text)) {}
+    OutboundMessage(std::string text, std::shared_ptr<const std::string> frame, bool compress,
+        std::shared_ptr<Compression::RoomStats> room_stats)
+        : text(std::move(text)), frame(std::move(frame)), compress(compress), room_stats(std::move(room_stats)) {}
+};
 
 class Client {
 public:
     SocketType socket_fd;
     std::string username;
-    std::string current_room;
+    std::string current_room;   // where plain lines go; one of `rooms`
+    std::set<std::string> rooms;                // guarded by the clients mutex
+    std::vector<std::string> subscriptions;     // patterns; guarded by the clients mutex
+    std::atomic<bool> multi_room{ false };      // in more than one room: label room messages
+    std::string resume_token;   // set at login for clients that negotiated resume
+    bool sequence_tags = false; // prefix room messages with "#<seq> "
+    bool password_verified = false; // logged in with a password from the credential file
 
-    std::queue<std::string> message_queue;
+    std::queue<OutboundMessage> message_queue;
     std::mutex queue_mutex;
     std::condition_variable queue_cv;
+    bool closed = false;        // guarded by queue_mutex
+    bool writer_parked = false; // guarded by queue_mutex; no notify needed while false
+    std::atomic<std::size_t> pending{ 0 }; // queue length, readable without the lock
+    std::chrono::steady_clock::time_point head_enqueued; // guarded by queue_mutex; when the oldest queued message arrived
+    // Set for clients that are not on a TCP socket; the writer hands its
+    // batches here instead of sending them
+    std::function<void(const std::vector<std::string>&)> deliver;
+    // Likewise: wakes the transport's reader when the server drops the
+    // session, since shutting down their setup socket does not
+    std::function<void()> abort;
+    std::atomic<bool> aborted{ false };
+
+    // Negotiated at login, before the writer starts; the writer's from then on
+    std::unique_ptr<Compression::Stream> deflater;
+
+    FloodControl::Budget flood;  // reader thread only
+    std::uint32_t capture_session = 0; // id in the traffic capture; 0 = not recorded
+
+    // Liveness tracking for the idle and heartbeat timers
+    std::atomic<std::int64_t> last_activity_ms{ 0 };
+    std::atomic<bool> awaiting_pong{ false };
+    std::atomic<TimingWheel::TimerId> idle_timer{ TimingWheel::INVALID_TIMER };
+    std::atomic<TimingWheel::TimerId> heartbeat_timer{ TimingWheel::INVALID_TIMER };
 
     Client(SocketType fd);
     ~Client();
-    void enqueueMessage(const std::string& msg);
+    void enqueueMessage(OutboundMessage msg);
     bool dequeueMessage(std::string& msg_out);
+    void close();
+    bool isClosed();
+
+    void touch();
+    std::chrono::milliseconds idleFor() const;
 };
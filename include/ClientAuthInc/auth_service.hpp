@@ -0,0 +1,109 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : auth_service.hpp
+ * Description : Password verification on a bounded worker pool, with a
+                 short-lived cache of verified logins and per-user throttling
+ ****************************************************/
+
+#pragma once
+#include "credential_store.hpp"
+#include "server_config.hpp"
+
+#include <windows.h>
+#include <bcrypt.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#pragma comment(lib, "bcrypt.lib")
+
+class AuthService {
+public:
+    enum class Outcome { Accepted, Rejected, Throttled, Busy };
+
+    AuthService(std::unique_ptr<CredentialStore> store, const ServerConfig& config);
+    ~AuthService();
+
+    AuthService(const AuthService&) = delete;
+    AuthService& operator=(const AuthService&) = delete;
+
+    // Throttled users and cache hits are answered on the calling thread;
+    // everything else waits for a worker. Busy means the queue is full.
+    // `source` identifies where the attempt came from (the peer address):
+    // failures lock out that user from that source only, so guessing at a
+    // name from one place cannot lock its owner out everywhere.
+    std::future<Outcome> verify(const std::string& username, const std::string& password,
+        const std::string& source);
+
+    // A reload empties the cache, so a changed password takes effect at once
+    bool reloadIfChanged();
+    std::string report() const;
+
+private:
+    using Digest = std::array<std::uint8_t, 32>;
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        std::string username;
+        std::string password;
+        std::string source;
+        std::promise<Outcome> result;
+    };
+
+    struct CacheEntry {
+        Digest digest;            // keyed HMAC of the password, never the password
+        Clock::time_point expires;
+    };
+
+    struct Failures {
+        int count = 0;
+        Clock::time_point locked_until{};
+    };
+
+    std::unique_ptr<CredentialStore> store;
+    BCRYPT_ALG_HANDLE hmac_sha256 = nullptr;
+    std::array<std::uint8_t, 32> cache_key{};   // random per process
+
+    std::size_t queue_limit;
+    std::chrono::seconds cache_ttl;
+    int max_failures;
+    std::chrono::seconds lockout;
+
+    std::deque<Job> jobs;
+    std::mutex job_mutex;
+    std::condition_variable job_cv;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    std::mutex state_mutex;   // guards cache, failures and generation
+    std::unordered_map<std::string, CacheEntry> cache;
+    std::uint64_t generation = 0;   // credential reloads so far
+    std::unordered_map<std::string, Failures> failures;   // by failureKey
+
+    std::atomic<std::uint64_t> verified{ 0 };
+    std::atomic<std::uint64_t> cache_hits{ 0 };
+    std::atomic<std::uint64_t> rejected{ 0 };
+    std::atomic<std::uint64_t> throttled{ 0 };
+    std::atomic<std::uint64_t> busy{ 0 };
+    std::atomic<std::uint64_t> hash_micros{ 0 };
+
+    static std::future<Outcome> ready(Outcome outcome);
+    Digest cacheDigest(const std::string& password) const;
+    bool derive(const std::string& password, const CredentialStore::Record& record,
+        std::vector<std::uint8_t>& out) const;
+    static std::string failureKey(const std::string& username, const std::string& source);
+    Outcome check(const Job& job);
+    void remember(const Job& job, bool accepted, std::uint64_t checked_generation);
+    void run();
+};
@@ -0,0 +1,74 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : busy_poll.hpp
+ * Description : Opt-in low-latency mode: adaptive spin-then-park for the
+                 writer queues and socket reads
+ ****************************************************/
+
+#pragma once
+#include "Client.hpp"
+#include "server_config.hpp"
+
+#include <winsock2.h>
+#include <atomic>
+#include <chrono>
+
+class BusyPoll {
+public:
+    // Per-waiter spin length. Spins that end with work grow the next one,
+    // spins that end in a park shrink it, so idle connections stop burning
+    // CPU on their own while busy ones stay hot.
+    struct Adaptive {
+        std::chrono::microseconds current{ 0 };
+        void onHit();
+        void onMiss();
+    };
+
+    static void configure(const ServerConfig& config);
+    static bool enabled() { return active; }
+
+    // Spins until ready() holds or the adaptive budget runs out. Only a
+    // bounded number of threads may spin at once; the rest return at once.
+    template <typename Ready>
+    static bool spin(Adaptive& adaptive, Ready ready);
+
+    // recv() that busy-polls the socket for a while before blocking
+    static int recv(SOCKET socket, char* buffer, int length, Adaptive& adaptive);
+
+    // Applied to the listener before bind(); accepted sockets inherit it
+    static void tuneListener(SOCKET socket);
+
+private:
+    static bool active;
+    static std::chrono::microseconds budget;
+    static std::chrono::microseconds floor;
+    static int max_spinners;
+    static std::atomic<int> spinners;
+
+    static bool enter();
+    static void leave();
+};
+
+template <typename Ready>
+bool BusyPoll::spin(Adaptive& adaptive, Ready ready) {
+    if (!active || !enter()) return ready();
+    if (adaptive.current.count() == 0) adaptive.current = budget;
+
+    auto deadline = std::chrono::steady_clock::now() + adaptive.current;
+    bool hit = false;
+    for (unsigned i = 1;; ++i) {
+        if (ready()) {
+            hit = true;
+            break;
+        }
+        YieldProcessor();
+        // Reading the clock is far dearer than a pause; check it sparingly
+        if ((i & 63) == 0 && std::chrono::steady_clock::now() >= deadline) break;
+    }
+    leave();
+
+    if (hit) adaptive.onHit();
+    else adaptive.onMiss();
+    return hit;
+}
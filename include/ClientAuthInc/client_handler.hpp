@@ -7,14 +7,21 @@
 
 #include "Client.hpp"
 #include "room_manager.hpp"
+#include "server_config.hpp"
+#include "session_store.hpp"
+#include "user_directory.hpp"
 
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <unordered_map>
 #include <iostream>
 #include <sstream>
+#include <functional>
+#include <string_view>
+#include <vector>
 
 #pragma comment(lib, "ws2_32.lib")
 
@@ -24,12 +31,27 @@
 class ClientHandler {
 private:
 	static std::string authenticateClient(int client_fd);
-	static std::shared_ptr<Client> registerClient(int client_fd, const std::string& username);
+	static bool checkPassword(int client_fd, const std::string& username);
+	static bool registerClient(std::shared_ptr<Client> client, const std::string& username);
+	static bool resumeSession(std::shared_ptr<Client> client, const std::string& input);
+	static void parkSession(std::shared_ptr<Client> client);
 	static void handleClientCommands(std::shared_ptr<Client> client);
+	static bool processInput(std::shared_ptr<Client> client, std::string_view raw);
+	static void sendDirectMessage(const std::string& input, std::shared_ptr<Client> client);
+	static void sendStats(std::shared_ptr<Client> client);
 	static void cleanupClient(std::shared_ptr<Client> client);
 
 public: 
+	// Applies the server configuration and starts the shared timer thread
+	static void configure(const ServerConfig& server_config);
 	static void handleClient(int client_fd);
+	// Sessions arriving over another transport (see LocalTransport)
+	static bool loginLocal(std::shared_ptr<Client> client, const std::string& username,
+		const std::string& password, std::string& error);
+	static void serveLocal(std::shared_ptr<Client> client, const std::function<bool(std::string&)>& next_line);
+	// Registers a section for the /stats report; registering a name again
+	// replaces that section
+	static void addStatsSource(const std::string& name, std::function<std::string()> source);
 };
 
 #endif
\ No newline at end of file
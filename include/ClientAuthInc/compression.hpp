@@ -0,0 +1,129 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : compression.hpp
+ * Description : Optional deflate compression of outbound traffic,
+                 negotiated per connection at login
+ ****************************************************/
+
+#pragma once
+#include "server_config.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+struct z_stream_s;
+
+// A client that logs in as "<name> +deflate" receives everything after the
+// welcome lines as one raw deflate stream (RFC 1951, no zlib header),
+// flushed to a byte boundary after every batch the writer sends. Each
+// connection has its own stream, so later lines compress against earlier
+// ones; compression_window_bits and compression_mem_level cap what that
+// costs per connection.
+//
+// At a flush point every such stream is byte-aligned, and a block that
+// only refers back into itself decodes the same in any of them. A room
+// message going to several compressing members is therefore compressed
+// once, from an empty window (a shared frame), and the same bytes are
+// spliced into each member's stream; the stream then takes the text as
+// preset dictionary so its own window stays in step with the client's.
+// Messages of rooms not listed in compression_rooms are spliced in as
+// stored blocks the same way.
+class Compression {
+public:
+    // Room messages to compressing clients, for /stats
+    struct RoomStats {
+        std::atomic<std::uint64_t> plain{ 0 };   // bytes before compression
+        std::atomic<std::uint64_t> wire{ 0 };    // bytes sent for them
+        std::atomic<std::uint64_t> micros{ 0 };  // time spent compressing
+    };
+
+    // One connection's deflate stream; used by its writer thread only.
+    // Shared-frame encoders pass connection = false and are not counted
+    // among the streams in /stats.
+    class Stream {
+    public:
+        explicit Stream(bool connection = true);
+        ~Stream();
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+
+        bool ok() const { return stream != nullptr; }
+
+        void compress(std::string_view text);
+        // `frame` is `text` already encoded from a flush point
+        void insert(std::string_view frame, std::string_view text);
+        void store(std::string_view text);
+        // Flushes and hands over everything encoded since the last call
+        std::string take();
+        // Back to an empty window; only for streams whose output starts afresh
+        void reset();
+
+    private:
+        z_stream_s* stream = nullptr;
+        std::string out;
+        bool unflushed = false;
+        bool counted = false;
+
+        void run(std::string_view input, int flush);
+        void flush();
+        void remember(std::string_view text);
+    };
+
+    static void configure(const ServerConfig& config);
+
+    // Built with zlib and switched on
+    static bool available() { return enabled; }
+    static int windowBits() { return window_bits; }
+    // Connections with a deflate stream; none means no room needs frames
+    static std::int64_t activeStreams() { return streams.load(std::memory_order_relaxed); }
+    static bool enabledFor(const std::string& room);
+    // Compressing members a room needs before its messages use shared frames
+    static std::size_t sharedMinimum() { return shared_minimum; }
+
+    // The same entry for a room's whole lifetime and after; rooms beyond
+    // the first MAX_ROOM_STATS are counted together
+    static std::shared_ptr<RoomStats> roomStats(const std::string& room);
+
+    // Compressed once for `recipients` streams, on the calling thread with
+    // an encoder borrowed from a small pool; call it without other locks held
+    static std::shared_ptr<const std::string> sharedFrame(std::string_view text, RoomStats& stats,
+        std::size_t recipients);
+    // Bytes a writer sent for `plain` bytes, charged to the room if any
+    static void noteSent(RoomStats* room, std::size_t plain, std::size_t wire, std::uint64_t micros);
+
+    static std::string report();
+
+private:
+    static constexpr std::size_t MAX_ROOM_STATS = 1024;
+
+    static bool enabled;
+    static int level;
+    static int window_bits;
+    static int mem_level;
+    static std::size_t shared_minimum;
+    static std::unordered_set<std::string> rooms;   // empty = every room
+
+    static std::mutex stats_mutex;
+    static std::map<std::string, std::shared_ptr<RoomStats>> room_stats;
+    static std::shared_ptr<RoomStats> other_rooms;
+
+    // Idle shared-frame encoders; more are made while every one is lent out
+    static constexpr std::size_t MAX_IDLE_ENCODERS = 4;
+    static std::mutex encoders_mutex;
+    static std::vector<std::unique_ptr<Stream>> idle_encoders;
+
+    static std::atomic<std::int64_t> streams;
+    static std::atomic<std::uint64_t> plain_bytes;
+    static std::atomic<std::uint64_t> wire_bytes;
+    static std::atomic<std::uint64_t> micros_spent;
+    static std::atomic<std::uint64_t> frames;
+    static std::atomic<std::uint64_t> frame_deliveries;
+};
@@ -0,0 +1,55 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : connection_limiter.hpp
+ * Description : Admission control for the accept loop: a global connection
+                 cap and per-source-IP token buckets
+ ****************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+class ConnectionLimiter {
+public:
+    enum class Verdict { Admit, RejectFull, RejectRate };
+
+    ConnectionLimiter(int max_connections, double per_ip_rate, double per_ip_burst,
+        std::size_t table_size);
+
+    // Called from the accept thread only; the IP table is not locked
+    Verdict admit(std::uint32_t ipv4);
+    // Called from handler threads when an admitted connection ends
+    void release();
+
+    int activeConnections() const { return active.load(std::memory_order_relaxed); }
+    std::uint64_t rejectedFull() const { return rejected_full; }
+    std::uint64_t rejectedRate() const { return rejected_rate; }
+
+private:
+    // 12 bytes per source address; ip == 0 marks an empty slot
+    struct Bucket {
+        std::uint32_t ip = 0;
+        float tokens = 0.0f;
+        std::uint32_t last_ms = 0;
+    };
+    static constexpr int MAX_PROBE = 8;
+
+    const int max_connections;
+    const float rate_per_ms;
+    const float burst;
+    std::vector<Bucket> table;
+    std::uint32_t mask;
+    int shift;
+    std::chrono::steady_clock::time_point origin;
+
+    std::atomic<int> active{ 0 };
+    std::uint64_t rejected_full = 0;
+    std::uint64_t rejected_rate = 0;
+
+    Bucket& lookup(std::uint32_t ip, std::uint32_t now_ms);
+    float refilled(const Bucket& bucket, std::uint32_t now_ms) const;
+};
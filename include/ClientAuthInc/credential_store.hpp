@@ -0,0 +1,50 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : credential_store.hpp
+ * Description : Password records for login, behind a small interface so
+                 other backends can replace the local file
+ ****************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CredentialStore {
+public:
+    // PBKDF2-HMAC-SHA256 verifier
+    struct Record {
+        std::vector<std::uint8_t> salt;
+        std::uint32_t iterations = 0;
+        std::vector<std::uint8_t> hash;
+    };
+
+    virtual ~CredentialStore() = default;
+    virtual std::optional<Record> lookup(const std::string& username) = 0;
+    virtual bool reloadIfChanged() { return false; }
+    // What a real record costs to check; unknown users are charged the same
+    virtual std::uint32_t typicalIterations() { return 100000; }
+};
+
+// One user per line: "<username>:<salt hex>:<iterations>:<hash hex>",
+// '#' starts a comment
+class FileCredentialStore : public CredentialStore {
+public:
+    bool load(const std::filesystem::path& path);
+    std::optional<Record> lookup(const std::string& username) override;
+    bool reloadIfChanged() override;
+    std::uint32_t typicalIterations() override;
+
+private:
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, Record> records;
+    std::uint32_t median_iterations = 100000;   // of the loaded records
+    std::filesystem::path source;
+    std::filesystem::file_time_type loaded_at{};
+};
@@ -0,0 +1,69 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : fanout_pool.hpp
+ * Description : Work-stealing worker pool and serial strands used to
+                 deliver broadcasts for very large rooms
+ ****************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class FanoutPool {
+public:
+    using Task = std::function<void()>;
+
+    // Worker i is pinned to cores[i % cores.size()] when cores are given
+    explicit FanoutPool(unsigned worker_count, const std::vector<int>& cores = {});
+    ~FanoutPool();
+
+    // From a worker thread the task goes to that worker's own deque (it is
+    // likely to touch the same data); otherwise workers are fed round-robin
+    void submit(Task task);
+    unsigned workerCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<unsigned> next_worker{ 0 };
+    std::atomic<int> pending{ 0 };
+    std::atomic<bool> running{ true };
+    std::mutex idle_mutex;
+    std::condition_variable idle_cv;
+
+    void run(unsigned index);
+    bool popLocal(unsigned index, Task& out);
+    bool steal(unsigned thief, Task& out);
+};
+
+// Runs posted tasks one at a time, in order, on whichever pool worker picks
+// the strand up. Different strands run in parallel.
+class Strand : public std::enable_shared_from_this<Strand> {
+public:
+    explicit Strand(FanoutPool& pool) : pool(pool) {}
+
+    void post(FanoutPool::Task task);
+
+private:
+    static constexpr int DRAIN_BUDGET = 16; // tasks per turn before yielding the worker
+
+    FanoutPool& pool;
+    std::mutex mutex;
+    std::deque<FanoutPool::Task> queue;
+    bool scheduled = false;
+
+    void drain();
+};
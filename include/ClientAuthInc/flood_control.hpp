@@ -0,0 +1,81 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : flood_control.hpp
+ * Description : Token-bucket rate limits on room messages, per connection
+                 and per room, checked before fan-out
+ ****************************************************/
+
+#pragma once
+#include "server_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Every room message costs one message token and one token per byte, from
+// the sender's buckets and from the room's. Within budget it passes; a
+// small overdraft is paid for by delaying the sender's next read; beyond
+// that the line is dropped, and a sender that keeps getting dropped is
+// disconnected. Only the sender's own strikes count towards a disconnect:
+// a busy room slows everyone down but blames no one.
+class FloodControl {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Bucket {
+        double tokens = 0.0;    // negative while in debt
+        Clock::time_point last; // unset until first use; a new bucket starts full
+    };
+
+    // Message and byte buckets of one connection or one room
+    struct Budget {
+        Bucket messages, bytes;
+        int strikes = 0;                // dropped lines within the strike window
+        Clock::time_point last_strike;
+    };
+
+    enum class Action { Pass, Delay, Drop, Disconnect };
+    struct Verdict {
+        Action action = Action::Pass;
+        std::chrono::milliseconds delay{ 0 };
+    };
+
+    explicit FloodControl(const ServerConfig& config);
+
+    bool enabled() const { return on; }
+    // `client` belongs to the calling reader thread and is not locked
+    Verdict check(Budget& client, const std::string& room, std::size_t bytes);
+    // Forgets rooms whose buckets have refilled; they carry no state
+    void sweep();
+    std::string report() const;
+
+private:
+    struct Limit {
+        double rate;    // tokens per second; 0 = unlimited
+        double burst;
+    };
+
+    Limit client_messages, client_bytes, room_messages, room_bytes;
+    std::chrono::milliseconds max_delay;
+    int disconnect_strikes;
+    std::chrono::seconds strike_window;
+    bool on;
+
+    std::mutex rooms_mutex;
+    std::unordered_map<std::string, Budget> rooms;
+
+    std::atomic<std::uint64_t> passed{ 0 };
+    std::atomic<std::uint64_t> delayed{ 0 };
+    std::atomic<std::uint64_t> delay_ms{ 0 };
+    std::atomic<std::uint64_t> dropped_client{ 0 };
+    std::atomic<std::uint64_t> dropped_room{ 0 };
+    std::atomic<std::uint64_t> disconnected{ 0 };
+
+    static void refill(Bucket& bucket, const Limit& limit, Clock::time_point now);
+    static double waitSeconds(const Bucket& bucket, const Limit& limit, double cost);
+    static void take(Bucket& bucket, const Limit& limit, double cost);
+};
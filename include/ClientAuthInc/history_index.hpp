@@ -0,0 +1,114 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : history_index.hpp
+ * Description : Recent room history with an incremental inverted index,
+                 queried by /search on a background thread
+ ****************************************************/
+
+#pragma once
+#include "Client.hpp"
+#include "server_config.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class HistoryIndex {
+public:
+    explicit HistoryIndex(const ServerConfig& config);
+    ~HistoryIndex();
+
+    HistoryIndex(const HistoryIndex&) = delete;
+    HistoryIndex& operator=(const HistoryIndex&) = delete;
+
+    // Records a delivered room message; only touches that room's partition
+    void add(const std::string& room, const std::string& line);
+
+    // Queues "/search <room> <terms>"; results arrive later on the client's
+    // outbound queue, one page per message. Only rooms the client is in can
+    // be searched; `mutex` is the one guarding client->rooms.
+    void search(const std::string& input, std::shared_ptr<Client> client, std::mutex& mutex);
+
+    std::string report() const;
+
+private:
+    // Posting list: ascending message ids, delta + varint encoded. Bytes
+    // before `head` belong to evicted messages and are compacted lazily.
+    struct Postings {
+        std::vector<std::uint8_t> bytes;
+        std::size_t head = 0;
+        std::uint64_t first = 0;   // id of the first live entry
+        std::uint64_t last = 0;    // id of the last entry, base for the next delta
+        std::uint32_t count = 0;
+    };
+
+    struct Message {
+        std::uint64_t id;
+        std::chrono::steady_clock::time_point time;
+        std::string text;
+    };
+
+    // One room's history; ids are dense, so message `id` lives at
+    // messages[id - messages.front().id]
+    struct RoomIndex {
+        std::mutex mutex;
+        std::deque<Message> messages;
+        std::unordered_map<std::string, Postings> terms;
+        std::uint64_t next_id = 0;
+        std::size_t posting_bytes = 0;
+    };
+
+    struct Query {
+        std::weak_ptr<Client> client;
+        std::string room;
+        std::vector<std::string> terms;
+    };
+
+    static constexpr std::size_t SHARD_COUNT = 16;
+    static constexpr std::size_t MAX_PENDING_QUERIES = 256;
+    static constexpr std::size_t MAX_TERM_LENGTH = 32;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<RoomIndex>> rooms;
+    };
+
+    std::chrono::seconds retention;
+    std::size_t max_messages;
+    std::size_t page_size;
+    std::size_t max_results;
+    std::array<Shard, SHARD_COUNT> shards;
+
+    std::deque<Query> queries;
+    std::mutex query_mutex;
+    std::condition_variable query_cv;
+    bool stopping = false;
+    std::thread worker;
+
+    std::atomic<std::uint64_t> messages_indexed{ 0 };
+    std::atomic<std::uint64_t> messages_evicted{ 0 };
+    std::atomic<std::uint64_t> queries_served{ 0 };
+    std::atomic<std::uint64_t> queries_refused{ 0 };
+
+    static std::vector<std::string> tokenize(const std::string& text);
+    static void append(Postings& postings, std::uint64_t id);
+    static void popFront(Postings& postings);
+    static std::vector<std::uint64_t> decode(const Postings& postings);
+
+    Shard& shardFor(const std::string& room);
+    std::shared_ptr<RoomIndex> findRoom(const std::string& room);
+    void evict(RoomIndex& index, std::chrono::steady_clock::time_point now);
+    void sweep();
+    void run();
+    void execute(const Query& query);
+};
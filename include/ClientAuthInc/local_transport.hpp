@@ -0,0 +1,52 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : local_transport.hpp
+ * Description : Transport for bots on the same host: session setup over a
+                 Unix domain socket, messages over shared-memory rings
+ ****************************************************/
+
+#pragma once
+#include "server_config.hpp"
+
+#include <winsock2.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// Handshake on the Unix socket:
+//   bot:    HELLO <username> [password]\n
+//   server: RING <name> <capacity>\n   or   ERR <reason>\n
+// The bot then opens SharedRingPair <name>: the first ring carries its
+// lines to the server, the second carries room traffic back. The socket
+// stays open for the life of the session; closing it, or a malformed frame
+// in the ring, ends the session. The HELLO must arrive within a few seconds,
+// and the bot must run under the server's account to open the rings.
+class LocalTransport {
+public:
+    explicit LocalTransport(const ServerConfig& config);
+    ~LocalTransport();
+
+    LocalTransport(const LocalTransport&) = delete;
+    LocalTransport& operator=(const LocalTransport&) = delete;
+
+    // False if AF_UNIX is unavailable or the path cannot be bound
+    bool start();
+    std::string report() const;
+
+private:
+    std::string path;
+    std::uint32_t ring_bytes;
+    SOCKET listener = INVALID_SOCKET;
+    std::thread acceptor;
+    std::atomic<bool> running{ false };
+
+    std::atomic<std::uint64_t> sessions{ 0 };
+    std::atomic<std::uint64_t> messages_in{ 0 };
+    std::atomic<std::uint64_t> messages_out{ 0 };
+    std::atomic<std::uint64_t> messages_dropped{ 0 };
+
+    void acceptLoop();
+    void serve(SOCKET socket);
+};
@@ -0,0 +1,53 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : output_coalescer.hpp
+ * Description : Adaptive batching of outbound chat lines: immediate flush
+                 when traffic is light, bounded hold-and-gather under load
+ ****************************************************/
+
+#pragma once
+#include "server_config.hpp"
+
+#include <winsock2.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+class OutputCoalescer {
+public:
+    // Records that `count` messages were just picked up by the writer
+    void noteArrivals(std::size_t count);
+
+    // Hold the batch only while messages arrive faster than the window:
+    // then waiting is likely to pick up more lines for the same segment
+    bool shouldHold() const;
+
+    static void configure(const ServerConfig& config);
+    static std::chrono::microseconds window() { return hold_window; }
+    static std::size_t flushBytes() { return flush_bytes; }
+
+    // Sends a batch as one gathered write per WSABUF group
+    static void send(SOCKET socket, const std::vector<std::string>& batch);
+    // Disables Nagle; batching is done here, where its latency is bounded
+    static void tuneSocket(SOCKET socket);
+    static std::string report();
+
+private:
+    static constexpr int MAX_BUFFERS = 64;    // WSABUFs per WSASend
+    static constexpr std::size_t SEGMENT_SIZE = 1460;
+
+    std::chrono::steady_clock::time_point last_arrival = std::chrono::steady_clock::now();
+    // EWMA of per-message inter-arrival time; starts at the window, so a
+    // burst on a fresh connection is coalesced after a pickup or two
+    double average_gap_us = static_cast<double>(hold_window.count());
+
+    static bool enabled;
+    static std::chrono::microseconds hold_window;
+    static std::size_t flush_bytes;
+
+    static std::atomic<std::uint64_t> messages_sent;
+    static std::atomic<std::uint64_t> send_calls;
+    static std::atomic<std::uint64_t> segments_estimated;
+};
@@ -0,0 +1,75 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : overload_controller.hpp
+ * Description : Watches scheduling lag and outbound queue sojourn time and
+                 sheds optional work while the server is saturated
+ ****************************************************/
+
+#pragma once
+#include "server_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// A probe thread wakes every overload_probe_interval and measures how late
+// it woke (scheduling lag: every runnable thread is competing for the
+// cores) and the 90th percentile of how long writers' oldest messages had
+// been queued (sojourn: clients are not being served in time). A percentile
+// across all writers, rather than the worst one, keeps a single slow reader
+// from looking like an overloaded server; writers only count the time they
+// were free to send, not time blocked on their own socket. Both are
+// smoothed and compared with their thresholds:
+//   Shedding - over the threshold: /rooms is deferred and monitors receive
+//              one room message in overload_monitor_sample
+//   Critical - over twice the threshold: new connections also wait in the
+//              listen backlog
+// Levels rise at once and fall one step at a time after a calm second, so
+// the server does not flap around a threshold.
+class OverloadController {
+public:
+    enum class Level { Normal = 0, Shedding = 1, Critical = 2 };
+
+    // Starts the probe thread on first use
+    static void configure(const ServerConfig& config);
+
+    static Level level() { return static_cast<Level>(current.load(std::memory_order_relaxed)); }
+    static bool shedding() { return level() >= Level::Shedding; }
+    static bool acceptsPaused() { return level() == Level::Critical; }
+    static bool tracking() { return enabled; }
+
+    // Called by writers for the oldest message of each batch, with the
+    // later of its enqueue time and the end of the writer's previous send
+    static void noteSojourn(std::chrono::steady_clock::time_point since);
+    // Whether a monitor gets the room message with this sequence number
+    static bool sampleMonitor(std::uint64_t seq);
+    static void noteDeferred() { deferred.fetch_add(1, std::memory_order_relaxed); }
+
+    static std::chrono::milliseconds probeInterval() { return interval; }
+    static std::string report();
+
+private:
+    static constexpr int CALM_TICKS_PER_STEP = 10;
+    // Sojourn histogram in quarters of the threshold; the last bucket is open
+    static constexpr int SOJOURN_BUCKETS = 12;
+    static constexpr double SOJOURN_BUCKET_WIDTH = 0.25;
+
+    static bool enabled;
+    static std::chrono::milliseconds interval;
+    static double lag_threshold_us;
+    static double sojourn_threshold_us;
+    static std::uint64_t monitor_sample;
+
+    static std::atomic<int> current;
+    static std::atomic<std::uint32_t> sojourn_buckets[SOJOURN_BUCKETS]; // since the last probe
+    static std::atomic<std::int64_t> lag_smoothed_us;
+    static std::atomic<std::int64_t> sojourn_smoothed_us;
+
+    static std::atomic<std::uint64_t> escalations;
+    static std::atomic<std::uint64_t> deferred;
+    static std::atomic<std::uint64_t> monitor_skipped;
+
+    static void probe();
+};
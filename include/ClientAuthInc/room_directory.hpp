@@ -0,0 +1,60 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : room_directory.hpp
+ * Description : Sorted room list with member counts, kept up to date on
+                 join/leave and served a page at a time for /rooms
+ ****************************************************/
+
+#pragma once
+#include "server_config.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// RoomManager reports every membership change here, which costs a map
+// update. Queries read an immutable sorted snapshot instead, rebuilt from
+// the map at most once per refresh interval and only if something changed;
+// a page is then a binary search plus page_size lines, and the rendered
+// text is cached with the snapshot. /rooms may lag joins by up to one
+// refresh interval.
+class RoomDirectory {
+public:
+    void configure(const ServerConfig& config);
+
+    void update(const std::string& room, std::size_t members);
+    void remove(const std::string& room);
+
+    // Rooms starting with `prefix`, 1-based `page`, as one message
+    std::string query(std::string_view prefix, std::size_t page);
+
+private:
+    static constexpr std::size_t MAX_CACHED_PAGES = 256;
+
+    struct Snapshot {
+        std::uint64_t version = 0;
+        std::vector<std::pair<std::string, std::size_t>> rooms;   // sorted by name
+
+        mutable std::mutex pages_mutex;
+        mutable std::unordered_map<std::string, std::string> pages; // "<page> <prefix>" -> text
+    };
+
+    std::size_t page_size = 50;
+    std::chrono::milliseconds refresh{ 250 };
+
+    std::mutex mutex;
+    std::map<std::string, std::size_t> rooms;
+    std::uint64_t version = 0;
+    std::shared_ptr<const Snapshot> snapshot = std::make_shared<Snapshot>();
+    std::chrono::steady_clock::time_point built_at;
+
+    std::shared_ptr<const Snapshot> current();
+    std::string render(const Snapshot& snap, std::string_view prefix, std::size_t page) const;
+};
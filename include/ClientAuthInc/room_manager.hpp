@@ -7,29 +7,134 @@
 
 #pragma once
 #include "Client.hpp"
+#include "compression.hpp"
+#include "fanout_pool.hpp"
+#include "room_directory.hpp"
+#include "server_config.hpp"
+#include "session_store.hpp"
+#include "subscription_trie.hpp"
 
+#include <cstdint>
+#include <deque>
 #include <unordered_map>
 #include <memory>
 #include <mutex>
 #include <unordered_set>
 #include <sstream>
+#include <vector>
 
 class RoomManager {
 private:
-    static std::unordered_map<std::string, std::unordered_set<int>> chat_rooms;
+    // Members of a large room, split into fixed partitions. A client always
+    // lands in the same partition, so it is always served by the same strand
+    // and sees the room's messages in order.
+    struct MemberSnapshot {
+        std::vector<std::vector<std::shared_ptr<Client>>> partitions;
+    };
+
+    struct Room {
+        std::unordered_set<int> members;
+        std::shared_ptr<const MemberSnapshot> snapshot;  // rebuilt after membership changes
+        std::vector<std::shared_ptr<Strand>> strands;    // one per partition, created lazily
+        std::shared_ptr<std::atomic<int>> in_flight = std::make_shared<std::atomic<int>>(0);
+
+        // Every message gets the next sequence number; the newest ones are
+        // kept so resumed sessions can catch up
+        std::uint64_t last_seq = 0;
+        std::deque<std::pair<std::uint64_t, std::string>> backlog;
+        int detached = 0;   // parked sessions that may come back; keeps the room alive
+
+        std::size_t compressing = 0;    // members that negotiated compression
+        std::shared_ptr<Compression::RoomStats> compression;    // set once one has
+    };
+
+    // One message as each kind of recipient sees it: "#<seq> " for clients
+    // that asked for sequence tags, "[room] " for clients in several rooms
+    // and for monitors. In rooms with compressing members it also carries
+    // how they get it.
+    struct Outgoing {
+        std::string plain, tagged, labelled, labelled_tagged;
+        std::shared_ptr<const std::string> frame;   // `plain`, compressed once
+        bool compress = true;
+        std::shared_ptr<Compression::RoomStats> stats;
+
+        const std::string& forRecipient(const Client& recipient, bool label) const;
+        OutboundMessage to(const Client& recipient, bool label) const;
+    };
+
+    static std::unordered_map<std::string, Room> chat_rooms;
+
+    // Strands and counters of erased rooms whose chunks were still in flight.
+    // A room recreated under the same name picks them up again, so its new
+    // messages queue behind the old chunks instead of overtaking them.
+    struct Draining {
+        std::vector<std::shared_ptr<Strand>> strands;
+        std::shared_ptr<std::atomic<int>> in_flight;
+    };
+    static std::unordered_map<std::string, Draining> draining;
+
+    // What /rooms reads; updated on every membership change
+    static RoomDirectory directory;
+
+    // Pattern subscriptions of monitoring clients, by socket
+    static SubscriptionTrie subscriptions;
+    static std::vector<int> matched;    // scratch for subscriptions.match, guarded like the rest
+    static std::size_t max_rooms;
+
+    // Parallel fan-out for rooms above fanout_threshold members
+    static std::unique_ptr<FanoutPool> fanout_pool;
+    static std::size_t fanout_threshold;
+    static std::size_t fanout_partitions;
+    static std::size_t backlog_limit;
+
+    static std::size_t partitionOf(int client_fd);
+    static void parallelBroadcast(Room& room, std::shared_ptr<const Outgoing> msg,
+        int client_fd, std::unordered_map<int, std::shared_ptr<Client>>& clients);
+    static Room& roomNamed(const std::string& room);
+    static void eraseIfUnused(const std::string& room);
+    static void removeMember(const std::string& room, int client_fd, Client& client);
+    static void dropMemberships(int client_fd, Client& client, const std::string& keep);
 public:
-	// Function declarations for managing chat rooms
+    static void configure(const ServerConfig& config);
+
+	// Function declarations for managing chat rooms. A client can be in
+	// several rooms; plain lines go to the one it joined or switched to last.
     static void joinRoom(const std::string& input, int client_fd, std::shared_ptr<Client> client,
         std::mutex& mutex,
         std::unordered_map<int, std::shared_ptr<Client>>& clients);
 
-    static void leaveRoom(int client_fd, std::shared_ptr<Client> client,
+    // "/leave [room]", the active room by default
+    static void leaveRoom(const std::string& input, int client_fd, std::shared_ptr<Client> client,
         std::mutex& mutex);
 
-    static void listRooms(std::shared_ptr<Client> client);
+    // Disconnect: leaves every room and drops all subscriptions
+    static void removeClient(int client_fd, std::shared_ptr<Client> client, std::mutex& mutex);
+
+    // "/rooms [prefix] [page]"; never touches chat_rooms
+    static void listRooms(const std::string& input, std::shared_ptr<Client> client);
+
+    // "/subscribe <pattern>" and friends: the client receives every message
+    // of every matching room without joining it (see SubscriptionTrie)
+    static void subscribe(const std::string& input, int client_fd, std::shared_ptr<Client> client, std::mutex& mutex);
+    static void unsubscribe(const std::string& input, int client_fd, std::shared_ptr<Client> client, std::mutex& mutex);
+    static void listSubscriptions(std::shared_ptr<Client> client, std::mutex& mutex);
+
+    // Session resume covers every room, the active one and the
+    // subscriptions. detachClient records them in the session and leaves
+    // each room like leaveRoom, but keeps it, and its sequence, alive until
+    // releaseDetached or resumeRooms.
+    static void detachClient(int client_fd, std::shared_ptr<Client> client, std::mutex& mutex,
+        SessionStore::Session& session);
+    static void releaseDetached(const SessionStore::Session& session, std::mutex& mutex);
+    // Re-joins the rooms and subscriptions and replays, per room, the
+    // messages after the client's last seen seq that are still in the
+    // backlog; rooms missing from last_seen count from the disconnect
+    static void resumeRooms(const SessionStore::Session& session,
+        const std::unordered_map<std::string, std::uint64_t>& last_seen, int client_fd,
+        std::shared_ptr<Client> client, std::mutex& mutex);
 
     static void broadcastMessage(const std::string& input, int client_fd,
         std::shared_ptr<Client> client,
         std::mutex& mutex,
         std::unordered_map<int, std::shared_ptr<Client>>& clients);
-};
\ No newline at end of file
+};
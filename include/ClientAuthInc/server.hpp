@@ -13,17 +13,29 @@
 #pragma comment(lib, "ws2_32.lib")
 
 #include "client_handler.hpp"
+#include "connection_limiter.hpp"
+#include "local_transport.hpp"
+#include "busy_poll.hpp"
+#include "output_coalescer.hpp"
+#include "overload_controller.hpp"
+#include "../ThreadPlacement.hpp"
 
 class Server {
 public:
-    Server(int port);
+    Server(int port, const ServerConfig& config = ServerConfig());
     void start();
 private:
     int port;
     int server_fd;
+    ServerConfig config;
+    ConnectionLimiter limiter;
+    ThreadPlacement placement;
+    std::unique_ptr<LocalTransport> local;
 
     // Function to set up the server socket
     void setupServerSocket();
 	// Function to accept incoming connections and handle them in separate threads
     void acceptConnections();
+    // Function to accept everything pending on the listener, up to one batch
+    void acceptBatch();
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : server_config.hpp
+ * Description : Tunables for the client authentication server
+ ****************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ServerConfig {
+    // Timers (driven by a single hierarchical timing wheel)
+    std::chrono::milliseconds timer_tick{ 100 };
+    std::chrono::seconds auth_timeout{ 30 };     // time allowed to send a username
+    std::chrono::seconds idle_timeout{ 600 };    // disconnect after this long without input
+    bool heartbeat_enabled = false;              // send PING to quiet clients, expect /pong
+    std::chrono::seconds heartbeat_interval{ 30 };
+    std::chrono::seconds heartbeat_timeout{ 10 };
+
+    // Accept pipeline
+    int accept_batch = 64;                       // sockets drained per listener wakeup
+    int max_connections = 10000;                 // beyond this, connections are reset immediately
+    double per_ip_connect_rate = 5.0;            // sustained new connections per second per source IP
+    double per_ip_connect_burst = 20.0;
+    std::size_t ip_table_size = 65536;           // tracked source addresses
+
+    // Broadcast fan-out
+    std::size_t fanout_threshold = 512;          // rooms at least this big fan out on the pool (0 = never)
+    std::size_t fanout_partitions = 64;          // recipient chunks per large room
+    unsigned fanout_workers = 0;                 // 0 = one per hardware thread
+
+    // Thread placement; empty lists leave scheduling to the OS
+    std::vector<int> network_cores;              // accept loop and per-connection threads
+    std::vector<int> worker_cores;               // fan-out pool workers
+
+    // Low-latency mode: waiters spin before parking instead of sleeping
+    bool busy_poll = false;
+    std::chrono::microseconds busy_poll_budget{ 50 }; // longest single spin
+    int busy_poll_max_spinners = 0;              // concurrent spinners; 0 = half the hardware threads
+
+    // Output coalescing: under load, hold outbound lines briefly and send
+    // them as one gathered write
+    bool coalesce_output = true;
+    std::chrono::microseconds coalesce_window{ 200 }; // longest hold
+    std::size_t coalesce_bytes = 1400;           // flush early once a segment's worth is queued
+
+    // Rooms
+    std::size_t max_rooms_per_client = 1;        // 1 = joining a room leaves the previous one; raise for multi-room
+    std::vector<std::string> monitor_users;      // may /subscribe to room patterns; needs credential_file
+    std::size_t rooms_page_size = 50;            // rooms per /rooms page
+    std::chrono::milliseconds rooms_refresh{ 250 }; // longest /rooms may lag behind joins and leaves
+
+    // Overload control: sheds optional work while scheduling lag or
+    // outbound queueing time is high (see OverloadController)
+    bool overload_control = true;
+    std::chrono::milliseconds overload_probe_interval{ 100 };
+    std::chrono::milliseconds overload_lag_threshold{ 50 };      // shedding above this, accepts paused above twice
+    std::chrono::milliseconds overload_sojourn_threshold{ 200 }; // likewise, for the 90th percentile of writers' queueing time
+    std::uint64_t overload_monitor_sample = 4;   // while shedding, monitors get one room message in this many
+
+    // Flood control on room messages, checked before fan-out; a rate of 0
+    // turns that budget off
+    double flood_client_msgs_per_sec = 5.0;      // per connection
+    double flood_client_msg_burst = 20.0;
+    double flood_client_bytes_per_sec = 4096.0;
+    double flood_client_byte_burst = 16384.0;
+    double flood_room_msgs_per_sec = 200.0;      // per room, all senders together
+    double flood_room_msg_burst = 400.0;
+    double flood_room_bytes_per_sec = 262144.0;
+    double flood_room_byte_burst = 524288.0;
+    std::chrono::milliseconds flood_max_delay{ 1000 }; // longer overdrafts drop the line instead of delaying
+    int flood_disconnect_strikes = 10;           // dropped lines within the window before a disconnect; 0 = never
+    std::chrono::seconds flood_strike_window{ 30 };
+    bool flood_exempt_local = true;              // local-transport bots skip both budgets
+
+    // Content filter; lines are always sanitised, the word list is optional
+    std::string filter_wordlist;                 // path to the block list; empty = no filtering
+
+    // Room history kept for /search
+    std::chrono::seconds history_retention{ 3600 }; // 0 = no history, /search disabled
+    std::size_t history_max_messages = 10000;    // per room
+    std::size_t search_page_size = 10;           // result lines per outbound message
+    std::size_t search_max_results = 50;         // newest matches returned per query
+
+    // Session resume: a dropped client that negotiated it at login can come
+    // back with its token and last-seen sequence number
+    std::chrono::seconds resume_grace{ 120 };    // how long a dropped session is kept; 0 = off
+    std::size_t resume_backlog = 256;            // recent messages kept per room for replay
+
+    // Password login; without a credential file any free name is accepted
+    std::string credential_file;
+    unsigned auth_workers = 0;                   // hashing threads; 0 = a quarter of the hardware threads
+    std::size_t auth_queue_limit = 256;          // pending verifications before logins are turned away
+    std::chrono::seconds auth_cache_ttl{ 300 };  // a verified login skips hashing for this long; 0 = no cache
+    int auth_max_failures = 5;                   // failed attempts before a user is locked out from that address
+    std::chrono::seconds auth_lockout{ 30 };     // first lockout; doubles with each further failure
+
+    // Local transport for bots on this host; empty path = off
+    std::string local_socket_path;
+    std::uint32_t local_ring_bytes = 1 << 20;    // per direction, rounded up to a power of two
+
+    // Traffic capture for tools/chat_replay: logins, every line read and
+    // disconnects, with timestamps; empty = off
+    std::string capture_file;
+
+    // Outbound compression for clients that log in as "<name> +deflate";
+    // needs a build with zlib (see Compression)
+    bool compression = true;
+    int compression_level = 6;                   // 1 = fastest .. 9 = smallest
+    int compression_window_bits = 12;            // 9..15; with mem_level, about (4 << bits) + (512 << mem_level) bytes per connection
+    int compression_mem_level = 5;               // 1..9
+    std::size_t compression_shared_min = 2;      // compressing room members before a message is compressed once for all
+    std::vector<std::string> compression_rooms;  // rooms whose messages are compressed; empty = all, others go stored
+
+    // How often the word list and credential file are checked for edits
+    std::chrono::seconds reload_interval{ 10 };
+
+    // Settings by field name, e.g. set("busy_poll", "true"); durations are
+    // counts in the field's unit, lists are comma separated. False for an
+    // unknown name or a value that does not parse.
+    bool set(const std::string& name, const std::string& value);
+
+    // A file of "name = value" lines, '#' starting a comment; on failure
+    // `error` says which line was wrong
+    bool load(const std::string& path, std::string& error);
+};
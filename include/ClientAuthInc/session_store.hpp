@@ -0,0 +1,56 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : session_store.hpp
+ * Description : Resume tokens and the sessions parked under them while a
+                 client is disconnected
+ ****************************************************/
+
+#pragma once
+#include "../TimingWheel.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class SessionStore {
+public:
+    // What a disconnected client left behind
+    struct Session {
+        std::string username;
+        // Every room it was in, with the room's sequence at the disconnect
+        std::vector<std::pair<std::string, std::uint64_t>> rooms;
+        std::string current_room;                       // empty if it was in no room
+        std::vector<std::string> subscriptions;
+        bool password_verified = false;
+        TimingWheel::TimerId expiry = TimingWheel::INVALID_TIMER;
+    };
+
+    // Unguessable 128-bit token, hex encoded
+    static std::string newToken();
+
+    void park(const std::string& token, Session session);
+    // Attaches the expiry timer to a parked session; false if it has been
+    // resumed meanwhile, and the caller should cancel the timer
+    bool setExpiry(const std::string& token, TimingWheel::TimerId expiry);
+    // Both remove and return the session; empty if unknown or already
+    // taken, so exactly one of resume and expiry wins
+    std::optional<Session> resume(const std::string& token);
+    std::optional<Session> expire(const std::string& token);
+
+    std::string report() const;
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Session> sessions;
+
+    std::optional<Session> take(const std::string& token);
+
+    std::atomic<std::uint64_t> parked{ 0 };
+    std::atomic<std::uint64_t> resumed{ 0 };
+};
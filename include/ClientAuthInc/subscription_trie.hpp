@@ -0,0 +1,57 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : subscription_trie.hpp
+ * Description : Room-name patterns for monitoring clients, indexed by
+                 dot-separated segment
+ ****************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Patterns are room names split on '.', where a '*' segment matches any one
+// segment, and a trailing '*' matches one or more: "support.*" covers
+// "support.billing" and "support.eu.billing", "*" covers every room.
+// Matching walks one trie level per segment of the room name, so its cost
+// does not grow with the number of subscriptions.
+class SubscriptionTrie {
+public:
+    static bool validPattern(std::string_view pattern);
+
+    bool add(std::string_view pattern, int subscriber);      // false if already present
+    bool remove(std::string_view pattern, int subscriber);   // false if not present
+    // Appends every subscriber with a pattern matching `room`, each once
+    void match(std::string_view room, std::vector<int>& out) const;
+    std::size_t size() const { return count; }
+
+private:
+    // Lets lookups take the room's segments as string_views, no copies
+    struct SegmentHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view segment) const { return std::hash<std::string_view>{}(segment); }
+    };
+
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>, SegmentHash, std::equal_to<>> children;
+        std::unique_ptr<Node> star;     // a '*' segment followed by more segments
+        std::vector<int> exact;         // patterns ending at this node
+        std::vector<int> rest;          // patterns ending in '*' right after this node
+
+        bool empty() const { return children.empty() && !star && exact.empty() && rest.empty(); }
+    };
+
+    Node root;
+    std::size_t count = 0;
+
+    static std::vector<std::string_view> split(std::string_view name);
+    static bool removeFrom(Node& node, const std::vector<std::string_view>& segments, std::size_t index,
+        int subscriber, bool& removed);
+    static void collect(const Node& node, const std::vector<std::string_view>& segments, std::size_t index,
+        std::vector<int>& out);
+};
@@ -0,0 +1,40 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : user_directory.hpp
+ * Description : Concurrent username -> client index used for uniqueness
+                 checks and direct messages
+ ****************************************************/
+
+#pragma once
+#include "Client.hpp"
+
+#include <array>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+class UserDirectory {
+private:
+    // Lock striping: lookups for different names rarely share a mutex, and
+    // readers (/msg delivery) never block each other
+    static constexpr std::size_t SHARD_COUNT = 64;
+
+    struct Shard {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<Client>> users;
+    };
+
+    static std::array<Shard, SHARD_COUNT> shards;
+    static Shard& shardFor(const std::string& username);
+
+public:
+    // Claims a username for a client; fails if someone else holds it
+    static bool claim(const std::string& username, std::shared_ptr<Client> client);
+
+    // Releases a username, but only if it still belongs to this client
+    static void release(const std::string& username, const Client* client);
+
+    static std::shared_ptr<Client> find(const std::string& username);
+};
@@ -0,0 +1,76 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : ContentFilter.hpp
+ * Description : Inline moderation stage: vectorised line sanitisation and
+                 an Aho-Corasick blocklist that can mask, reject or flag
+ ****************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ContentFilter {
+public:
+    // Ordered by severity: the strongest action of any match wins
+    enum class Action : std::uint8_t { None = 0, Flag = 1, Mask = 2, Reject = 3 };
+
+    struct Result {
+        Action action = Action::None;   // Mask here means text was rewritten
+        bool flagged = false;
+        std::string text;
+    };
+
+    // Drops control characters (keeping tab), applies backspace/DEL to the
+    // preceding character and replaces malformed UTF-8 with U+FFFD. Runs of
+    // printable ASCII are skipped 16 bytes at a time.
+    static std::string sanitize(std::string_view input);
+
+    // Word list format, one entry per line: "<word> [mask|reject|flag]",
+    // default mask, '#' starts a comment. Matching is ASCII case-insensitive.
+    bool load(const std::filesystem::path& path);
+    // Recompiles if the file changed since the last load; safe to call
+    // while other threads are filtering
+    bool reloadIfChanged();
+
+    Result apply(std::string_view line);
+    bool enabled() const;
+    std::string report() const;
+
+private:
+    // Dense DFA over byte classes: only bytes that occur in some pattern get
+    // their own column, everything else shares class 0. Transitions hold the
+    // target row offset (state * class_count) so the scan never multiplies,
+    // with MATCH_BIT set when some pattern ends in the target state.
+    struct Automaton {
+        static constexpr std::uint32_t MATCH_BIT = 0x80000000u;
+
+        std::uint8_t byte_class[256] = {};
+        std::uint32_t class_count = 1;
+        std::size_t max_length = 0;                 // longest pattern
+        std::vector<std::uint32_t> next;            // row offset + class -> tagged row offset
+        std::vector<std::uint16_t> mask_length;     // per state: longest Mask pattern ending here
+        std::vector<std::uint8_t> actions;          // per state: bit (1 << Action) for each ending pattern
+    };
+
+    static std::shared_ptr<const Automaton> compile(
+        const std::vector<std::pair<std::string, Action>>& patterns);
+
+    std::atomic<std::shared_ptr<const Automaton>> automaton;
+    std::mutex reload_mutex;
+    std::filesystem::path source;
+    std::filesystem::file_time_type loaded_at{};
+
+    std::atomic<std::uint64_t> lines_scanned{ 0 };
+    std::atomic<std::uint64_t> bytes_scanned{ 0 };
+    std::atomic<std::uint64_t> lines_masked{ 0 };
+    std::atomic<std::uint64_t> lines_rejected{ 0 };
+    std::atomic<std::uint64_t> lines_flagged{ 0 };
+};
@@ -0,0 +1,99 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : SharedRing.hpp
+ * Description : Single-producer/single-consumer message ring in named
+                 shared memory, with event wake-ups for parked consumers
+ ****************************************************/
+
+#pragma once
+
+#include <windows.h>
+#include <sddl.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#pragma comment(lib, "advapi32.lib")
+
+// View of one ring inside a mapping. Messages are framed as a 4-byte
+// length plus payload, padded to 4 bytes; a frame that would straddle the
+// end of the buffer is preceded by a wrap marker and starts over at 0.
+// Everything in the mapping is writable by the peer, so the consumer checks
+// each frame against its own copy of the capacity before trusting it.
+class SharedRing {
+public:
+    enum class Wait { Ready, Timeout, Other };
+
+    struct Header {
+        alignas(64) std::atomic<std::uint64_t> head;   // consumer position (bytes)
+        alignas(64) std::atomic<std::uint64_t> tail;   // producer position (bytes)
+        alignas(64) std::atomic<std::uint32_t> consumer_parked;
+        std::atomic<std::uint32_t> producer_parked;
+        std::uint32_t capacity;                        // power of two
+    };
+
+    SharedRing() = default;
+    SharedRing(Header* header, char* data, std::uint32_t capacity, HANDLE data_event, HANDLE space_event)
+        : header(header), data(data), size(capacity), data_event(data_event), space_event(space_event) {}
+
+    static std::size_t footprint(std::uint32_t capacity) { return sizeof(Header) + capacity; }
+    std::uint32_t capacity() const { return size; }
+    std::size_t maxMessage() const { return size / 2 - 8; }
+
+    // Copies the message in; false if it does not fit right now (or ever,
+    // if it is longer than maxMessage)
+    bool push(std::string_view message);
+    bool pop(std::string& out);
+    // Set for good once the peer has written a frame or position that does
+    // not fit the ring; push and pop then always fail
+    bool corrupt() const { return broken; }
+
+    // Park until the ring has data / room for `message` bytes, the timeout
+    // passes, or `other` (e.g. a socket close event) is signalled
+    Wait waitReadable(DWORD timeout_ms, HANDLE other = nullptr);
+    Wait waitWritable(std::size_t message, DWORD timeout_ms, HANDLE other = nullptr);
+
+private:
+    static constexpr std::uint32_t WRAP = 0xFFFFFFFFu;
+
+    Header* header = nullptr;
+    char* data = nullptr;
+    std::uint32_t size = 0;         // ours, not the header's: the peer can rewrite that
+    bool broken = false;
+    HANDLE data_event = nullptr;    // signalled by the producer
+    HANDLE space_event = nullptr;   // signalled by the consumer
+
+    bool empty() const;
+    bool hasRoom(std::size_t message) const;
+};
+
+// Two rings in one mapping, one per direction, plus their four events.
+// The server creates the pair; the peer opens it by name and gets the rings
+// the other way round. The mapping and events admit only the account the
+// creator runs as, so the peer must run under the same user.
+class SharedRingPair {
+public:
+    ~SharedRingPair();
+
+    SharedRingPair(const SharedRingPair&) = delete;
+    SharedRingPair& operator=(const SharedRingPair&) = delete;
+
+    static std::unique_ptr<SharedRingPair> create(const std::string& name, std::uint32_t capacity);
+    static std::unique_ptr<SharedRingPair> open(const std::string& name, std::uint32_t capacity);
+
+    SharedRing& inbound() { return rings[creator ? 0 : 1]; }    // peer -> us
+    SharedRing& outbound() { return rings[creator ? 1 : 0]; }   // us -> peer
+
+private:
+    SharedRingPair() = default;
+    static std::unique_ptr<SharedRingPair> map(const std::string& name, std::uint32_t capacity, bool create);
+
+    bool creator = false;
+    HANDLE mapping = nullptr;
+    void* view = nullptr;
+    HANDLE events[4] = {};
+    SharedRing rings[2];
+};
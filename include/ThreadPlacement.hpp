@@ -0,0 +1,91 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : ThreadPlacement.hpp
+ * Description : CPU pinning, RSS-aware connection steering and NUMA-local
+                 allocation for network and worker threads
+ ****************************************************/
+
+#pragma once
+
+#include <winsock2.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Cores are numbered group * 64 + processor number, so hosts with more
+// than 64 logical processors (several processor groups) work unchanged.
+class ThreadPlacement {
+public:
+    explicit ThreadPlacement(std::vector<int> cores);
+
+    // Picks the core that should serve a new connection: the core whose RSS
+    // queue receives its packets if we own it, otherwise one of our cores on
+    // the same NUMA node, otherwise round-robin. Returns -1 when no cores
+    // are configured (threads then float as before).
+    int steer(SOCKET socket);
+
+    // Round-robin pick for threads that are not tied to a connection
+    int next();
+
+    bool empty() const { return cores.empty(); }
+    std::string report() const;
+
+    static bool pinCurrentThread(int core);
+    static int pinnedCore();            // core this thread was pinned to, or -1
+    static int numaNodeOf(int core);
+    static int currentNumaNode();
+    // Windows counterpart of SO_INCOMING_CPU; -1 if the stack cannot tell
+    static int incomingCpu(SOCKET socket, int* numa_node = nullptr);
+
+private:
+    struct CoreStats {
+        std::atomic<std::uint64_t> connections{ 0 };
+        std::atomic<std::uint64_t> rx_local{ 0 };     // served on the RSS core itself
+        std::atomic<std::uint64_t> node_local{ 0 };   // same NUMA node as the RSS core
+        std::atomic<std::uint64_t> remote{ 0 };       // crossed nodes (or RSS unknown)
+    };
+
+    std::vector<int> cores;
+    std::vector<int> nodes;             // NUMA node of each entry in cores
+    std::vector<std::unique_ptr<CoreStats>> stats;
+    std::atomic<unsigned> cursor{ 0 };
+
+    std::size_t pick(int rx_cpu, int rx_node);
+};
+
+// Small-object arena backed by memory committed on a specific NUMA node.
+// Blocks are recycled per node and size class and never returned to the OS.
+namespace NumaArena {
+    void* allocate(std::size_t bytes, int node);
+    void deallocate(void* ptr, std::size_t bytes, int node);
+}
+
+// Allocator for connection state, e.g. std::allocate_shared<Client>; it
+// carries its node so memory goes back to the arena it came from. Only the
+// object itself lands in the arena: the heap buffers of its strings and
+// queues still come from the default heap.
+template <typename T>
+struct NumaAllocator {
+    using value_type = T;
+    int node;
+
+    explicit NumaAllocator(int node = ThreadPlacement::currentNumaNode()) : node(node) {}
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) : node(other.node) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(NumaArena::allocate(n * sizeof(T), node));
+    }
+    void deallocate(T* ptr, std::size_t n) {
+        NumaArena::deallocate(ptr, n * sizeof(T), node);
+    }
+
+    template <typename U>
+    bool operator==(const NumaAllocator<U>& other) const { return node == other.node; }
+    template <typename U>
+    bool operator!=(const NumaAllocator<U>& other) const { return node != other.node; }
+};
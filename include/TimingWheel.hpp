@@ -0,0 +1,106 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : TimingWheel.hpp
+ * Description : Hierarchical timing wheel (O(1) schedule/cancel) and a
+                 locked wrapper that drives it from a single timer thread.
+ ****************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Four-level wheel in the style of the classic kernel timer wheel:
+// level 0 holds the next 256 ticks, each higher level holds 64 slots that
+// are cascaded down one level whenever the lower level wraps around.
+// Schedule and cancel are O(1); expiry is amortised O(1) per timer.
+// Not thread-safe: use it from one event loop, or through TimerService.
+class TimingWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+    // Generation in the high 32 bits, slot index in the low 32 bits, so a
+    // stale id never cancels a timer that reused the same node.
+    using TimerId = std::uint64_t;
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    explicit TimingWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(100));
+
+    TimerId schedule(std::chrono::milliseconds delay, Callback cb);
+    bool cancel(TimerId id);
+
+    // Moves the wheel up to `now` and appends every expired callback to
+    // `expired`. Callbacks are handed out rather than invoked so callers can
+    // run them without holding their own locks.
+    void advance(Clock::time_point now, std::vector<Callback>& expired);
+
+    std::chrono::milliseconds tickInterval() const { return tick; }
+    std::size_t size() const { return active_count; }
+
+private:
+    static constexpr int ROOT_BITS = 8;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int LEVELS = 3; // levels above the root
+    static constexpr std::uint32_t ROOT_SIZE = 1u << ROOT_BITS;
+    static constexpr std::uint32_t LEVEL_SIZE = 1u << LEVEL_BITS;
+    static constexpr std::uint32_t SLOT_COUNT = ROOT_SIZE + LEVELS * LEVEL_SIZE;
+    static constexpr std::uint64_t MAX_DELTA = (1ull << (ROOT_BITS + LEVELS * LEVEL_BITS)) - 1;
+    static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node {
+        std::uint32_t prev = NIL;
+        std::uint32_t next = NIL;
+        std::uint32_t slot = NIL;       // NIL when the node is free
+        std::uint32_t generation = 1;
+        std::uint64_t expires = 0;      // absolute tick
+        Callback callback;
+    };
+
+    std::chrono::milliseconds tick;
+    Clock::time_point origin;
+    std::uint64_t current_tick = 0;     // next tick to be processed
+    std::size_t active_count = 0;
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> free_nodes;
+    std::array<std::uint32_t, SLOT_COUNT> heads;
+
+    std::uint32_t allocNode();
+    void releaseNode(std::uint32_t index);
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+    std::uint32_t cascade(int level);
+    void processTick(std::vector<Callback>& expired);
+};
+
+// Thread-safe front end for the chat server: a single background thread
+// advances the wheel once per tick and runs the expired callbacks with the
+// lock released, so callbacks may freely schedule or cancel timers.
+class TimerService {
+public:
+    explicit TimerService(std::chrono::milliseconds tick = std::chrono::milliseconds(100));
+    ~TimerService();
+
+    void start();
+    void stop();
+
+    TimingWheel::TimerId schedule(std::chrono::milliseconds delay, TimingWheel::Callback cb);
+    bool cancel(TimingWheel::TimerId id);
+
+private:
+    TimingWheel wheel;
+    std::mutex mutex;
+    std::condition_variable stop_cv;
+    std::thread worker;
+    std::atomic<bool> running{ false };
+
+    void run();
+};
@@ -0,0 +1,75 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : TrafficCapture.hpp
+ * Description : Compact binary recording of inbound client sessions, and
+                 the reader tools/chat_replay uses to play them back
+ ****************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// File layout: the 8-byte magic "CHATCAP1", the wall-clock start time in
+// milliseconds (8 bytes, little-endian), then one record per event:
+//   u8 type | varint microseconds since the previous record | varint session
+//   | Login and Line only: varint length, then that many bytes
+// A Line is one read as the server saw it, so replaying it reproduces the
+// same chunking. Passwords are never recorded.
+namespace TrafficCapture {
+    enum class Type : std::uint8_t { Login = 1, Line = 2, Close = 3 };
+
+    struct Record {
+        Type type = Type::Line;
+        std::uint64_t at_us = 0;        // since the start of the capture
+        std::uint32_t session = 0;
+        std::string data;               // username for Login, the bytes read for Line
+    };
+
+    // Thread-safe; records are buffered and written out in large blocks
+    class Writer {
+    public:
+        // False if the file cannot be created
+        bool open(const std::string& path);
+        bool isOpen() const { return out.is_open(); }
+
+        void login(std::uint32_t session, std::string_view username);
+        void line(std::uint32_t session, std::string_view data);
+        void close(std::uint32_t session);
+        void flush();
+
+        ~Writer();
+
+    private:
+        static constexpr std::size_t FLUSH_BYTES = 64 * 1024;
+
+        std::mutex mutex;
+        std::ofstream out;
+        std::string buffer;
+        std::chrono::steady_clock::time_point start;
+        std::uint64_t last_us = 0;
+
+        void append(Type type, std::uint32_t session, std::string_view data);
+    };
+
+    class Reader {
+    public:
+        // False if the file is missing or not a capture
+        bool open(const std::string& path);
+        // False at the end of the file or on a truncated record
+        bool next(Record& record);
+        std::uint64_t startedAtMs() const { return started_ms; }
+
+    private:
+        std::ifstream in;
+        std::uint64_t started_ms = 0;
+        std::uint64_t now_us = 0;
+
+        bool readVarint(std::uint64_t& value);
+    };
+}
@@ -0,0 +1,17 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : ChatServer.cpp
+ * Description : The ready-made ChatServer instantiations, compiled once
+ ****************************************************/
+
+#include "../include/ChatServer.hpp"
+
+template class ChatServer<ChatPolicy::BlockingIo, ChatPolicy::LineFraming,
+    ChatPolicy::SingleConnection, ChatPolicy::EchoSession>;
+template class ChatServer<ChatPolicy::BlockingIo, ChatPolicy::LineFraming,
+    ChatPolicy::ThreadPerConnection, ChatPolicy::AcknowledgeSession>;
+template class ChatServer<ChatPolicy::SelectIo, ChatPolicy::LineFraming,
+    ChatPolicy::Sequential, ChatPolicy::BroadcastSession>;
+template class ChatServer<ChatPolicy::BlockingIo, ChatPolicy::ChunkFraming,
+    ChatPolicy::ThreadPerConnection, ChatPolicy::BroadcastSession>;
@@ -1,6 +1,13 @@
 #include "../../include/ClientAuthInc/Client.hpp"
 
-Client::Client(SocketType fd) : socket_fd(fd) {}
+namespace {
+    std::int64_t steadyMillis() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+Client::Client(SocketType fd) : socket_fd(fd), last_activity_ms(steadyMillis()) {}
 
 // Destructor for Client class
 Client::~Client() {
@@ -9,16 +16,42 @@ Client::~Client() {
     }
 }
 
-void Client::enqueueMessage(const std::string& msg) {
+void Client::enqueueMessage(OutboundMessage msg) {
     std::lock_guard<std::mutex> lock(queue_mutex);
-    message_queue.push(msg);
-    queue_cv.notify_one();
+    if (closed) return;
+    if (message_queue.empty()) head_enqueued = std::chrono::steady_clock::now();
+    message_queue.push(std::move(msg));
+    pending.fetch_add(1, std::memory_order_release);
+    // A spinning writer picks the message up itself; skip the wake-up
+    if (writer_parked) queue_cv.notify_one();
 }
 
 bool Client::dequeueMessage(std::string& msg_out) {
     std::unique_lock<std::mutex> lock(queue_mutex);
     if (message_queue.empty()) return false;
-    msg_out = message_queue.front();
+    msg_out = std::move(message_queue.front().text);
     message_queue.pop();
+    pending.fetch_sub(1, std::memory_order_relaxed);
     return true;
-}
\ No newline at end of file
+}
+// Stops accepting messages and wakes the writer thread so it can exit
+void Client::close() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    closed = true;
+    queue_cv.notify_all();
+}
+
+bool Client::isClosed() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    return closed;
+}
+
+// Records inbound traffic; any line counts as an answer to a pending PING
+void Client::touch() {
+    last_activity_ms.store(steadyMillis(), std::memory_order_relaxed);
+    awaiting_pong.store(false, std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds Client::idleFor() const {
+    return std::chrono::milliseconds(steadyMillis() - last_activity_ms.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,213 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : auth_service.cpp
+ * Description : Password verification on a bounded worker pool, with a
+                 short-lived cache of verified logins and per-user throttling
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/auth_service.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    constexpr std::size_t MAX_TRACKED_FAILURES = 65536;
+
+    bool equalConstantTime(const std::uint8_t* a, const std::uint8_t* b, std::size_t length) {
+        std::uint8_t difference = 0;
+        for (std::size_t i = 0; i < length; ++i) difference |= a[i] ^ b[i];
+        return difference == 0;
+    }
+}
+
+AuthService::AuthService(std::unique_ptr<CredentialStore> store, const ServerConfig& config)
+    : store(std::move(store)),
+      queue_limit((std::max)(config.auth_queue_limit, std::size_t{ 1 })),
+      cache_ttl(config.auth_cache_ttl),
+      max_failures((std::max)(config.auth_max_failures, 1)),
+      lockout(config.auth_lockout) {
+    if (!BCRYPT_SUCCESS(BCryptOpenAlgorithmProvider(&hmac_sha256, BCRYPT_SHA256_ALGORITHM, nullptr,
+        BCRYPT_ALG_HANDLE_HMAC_FLAG))) {
+        std::cerr << "Auth: HMAC-SHA256 provider unavailable, every login will be rejected" << std::endl;
+        hmac_sha256 = nullptr;
+    }
+    BCryptGenRandom(nullptr, cache_key.data(), static_cast<ULONG>(cache_key.size()), BCRYPT_USE_SYSTEM_PREFERRED_RNG);
+
+    unsigned count = config.auth_workers > 0
+        ? config.auth_workers : (std::max)(1u, std::thread::hardware_concurrency() / 4);
+    for (unsigned i = 0; i < count; ++i)
+        workers.emplace_back([this] { run(); });
+}
+
+AuthService::~AuthService() {
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        stopping = true;
+    }
+    job_cv.notify_all();
+    for (auto& worker : workers) worker.join();
+    if (hmac_sha256) BCryptCloseAlgorithmProvider(hmac_sha256, 0);
+}
+
+std::future<AuthService::Outcome> AuthService::ready(Outcome outcome) {
+    std::promise<Outcome> promise;
+    promise.set_value(outcome);
+    return promise.get_future();
+}
+
+// Keyed, so a dump of the cache is no use for guessing passwords offline
+AuthService::Digest AuthService::cacheDigest(const std::string& password) const {
+    Digest digest{};
+    if (hmac_sha256) {
+        BCryptHash(hmac_sha256, const_cast<PUCHAR>(cache_key.data()), static_cast<ULONG>(cache_key.size()),
+            reinterpret_cast<PUCHAR>(const_cast<char*>(password.data())), static_cast<ULONG>(password.size()),
+            digest.data(), static_cast<ULONG>(digest.size()));
+    }
+    return digest;
+}
+
+bool AuthService::derive(const std::string& password, const CredentialStore::Record& record,
+    std::vector<std::uint8_t>& out) const {
+    out.assign(record.hash.empty() ? 32 : record.hash.size(), 0);
+    if (!hmac_sha256) return false;
+    return BCRYPT_SUCCESS(BCryptDeriveKeyPBKDF2(hmac_sha256,
+        reinterpret_cast<PUCHAR>(const_cast<char*>(password.data())), static_cast<ULONG>(password.size()),
+        const_cast<PUCHAR>(record.salt.data()), static_cast<ULONG>(record.salt.size()),
+        record.iterations, out.data(), static_cast<ULONG>(out.size()), 0));
+}
+
+// Usernames never contain a newline, so the key cannot be forged
+std::string AuthService::failureKey(const std::string& username, const std::string& source) {
+    return username + "\n" + source;
+}
+
+std::future<AuthService::Outcome> AuthService::verify(const std::string& username, const std::string& password,
+    const std::string& source) {
+    Digest digest = cacheDigest(password);
+    auto now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        auto failed = failures.find(failureKey(username, source));
+        if (failed != failures.end() && now < failed->second.locked_until) {
+            throttled.fetch_add(1, std::memory_order_relaxed);
+            return ready(Outcome::Throttled);
+        }
+        auto cached = cache.find(username);
+        if (cached != cache.end() && now < cached->second.expires
+            && equalConstantTime(cached->second.digest.data(), digest.data(), digest.size())) {
+            cache_hits.fetch_add(1, std::memory_order_relaxed);
+            return ready(Outcome::Accepted);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(job_mutex);
+    if (jobs.size() >= queue_limit) {
+        busy.fetch_add(1, std::memory_order_relaxed);
+        return ready(Outcome::Busy);
+    }
+    jobs.push_back({ username, password, source, {} });
+    std::future<Outcome> result = jobs.back().result.get_future();
+    job_cv.notify_one();
+    return result;
+}
+
+void AuthService::run() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(job_mutex);
+            job_cv.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) break;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job.result.set_value(check(job));
+    }
+
+    // Anyone still waiting gets an answer rather than a broken promise
+    std::lock_guard<std::mutex> lock(job_mutex);
+    for (auto& job : jobs) job.result.set_value(Outcome::Busy);
+    jobs.clear();
+}
+
+bool AuthService::reloadIfChanged() {
+    if (!store->reloadIfChanged()) return false;
+    std::lock_guard<std::mutex> lock(state_mutex);
+    ++generation;
+    cache.clear();
+    return true;
+}
+
+AuthService::Outcome AuthService::check(const Job& job) {
+    const std::string& password = job.password;
+    auto started = Clock::now();
+    std::uint64_t checked_generation;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        checked_generation = generation;
+    }
+    std::optional<CredentialStore::Record> found = store->lookup(job.username);
+    // Unknown users still pay for one derivation as costly as a typical
+    // real one, so response time does not reveal which names exist
+    CredentialStore::Record dummy;
+    if (!found) {
+        dummy.salt.assign(16, 0);
+        dummy.iterations = store->typicalIterations();
+    }
+    const CredentialStore::Record& stored = found ? *found : dummy;
+
+    std::vector<std::uint8_t> derived;
+    bool accepted = derive(password, stored, derived) && found
+        && derived.size() == stored.hash.size()
+        && equalConstantTime(derived.data(), stored.hash.data(), derived.size());
+    hash_micros.fetch_add(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started).count()),
+        std::memory_order_relaxed);
+
+    remember(job, accepted, checked_generation);
+    return accepted ? Outcome::Accepted : Outcome::Rejected;
+}
+
+// Successes go into the cache, unless the credentials were reloaded while
+// they were checked; failures back off exponentially once a user reaches
+// max_failures from one source. A failure leaves the cache alone: it cannot
+// match a cached digest anyway, and evicting it would let anyone push the
+// user's next login back onto the hashing pool.
+void AuthService::remember(const Job& job, bool accepted, std::uint64_t checked_generation) {
+    auto now = Clock::now();
+    Digest digest = accepted ? cacheDigest(job.password) : Digest{};
+    std::string key = failureKey(job.username, job.source);
+    std::lock_guard<std::mutex> lock(state_mutex);
+    if (accepted) {
+        verified.fetch_add(1, std::memory_order_relaxed);
+        failures.erase(key);
+        if (cache_ttl.count() > 0 && checked_generation == generation)
+            cache[job.username] = { digest, now + cache_ttl };
+        return;
+    }
+
+    rejected.fetch_add(1, std::memory_order_relaxed);
+    if (failures.size() >= MAX_TRACKED_FAILURES) {
+        std::erase_if(failures, [now](const auto& entry) { return entry.second.locked_until <= now; });
+    }
+    Failures& failed = failures[key];
+    if (++failed.count >= max_failures) {
+        int doublings = (std::min)(failed.count - max_failures, 6);
+        failed.locked_until = now + lockout * (1 << doublings);
+    }
+}
+
+std::string AuthService::report() const {
+    std::uint64_t derived = verified.load(std::memory_order_relaxed) + rejected.load(std::memory_order_relaxed);
+    std::ostringstream out;
+    out << "Auth: " << verified.load(std::memory_order_relaxed) << " verified, "
+        << cache_hits.load(std::memory_order_relaxed) << " from cache, "
+        << rejected.load(std::memory_order_relaxed) << " rejected, "
+        << throttled.load(std::memory_order_relaxed) << " throttled, "
+        << busy.load(std::memory_order_relaxed) << " turned away (queue full), "
+        << (derived > 0 ? hash_micros.load(std::memory_order_relaxed) / derived : 0) << " us per hash, "
+        << workers.size() << " workers\n";
+    return out.str();
+}
@@ -0,0 +1,68 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : busy_poll.cpp
+ * Description : Opt-in low-latency mode: adaptive spin-then-park for the
+                 writer queues and socket reads
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/busy_poll.hpp"
+
+#include <mstcpip.h>
+#include <algorithm>
+#include <thread>
+
+bool BusyPoll::active = false;
+std::chrono::microseconds BusyPoll::budget{ 0 };
+std::chrono::microseconds BusyPoll::floor{ 0 };
+int BusyPoll::max_spinners = 0;
+std::atomic<int> BusyPoll::spinners{ 0 };
+
+void BusyPoll::configure(const ServerConfig& config) {
+    active = config.busy_poll && config.busy_poll_budget.count() > 0;
+    budget = config.busy_poll_budget;
+    floor = (std::max)(budget / 16, std::chrono::microseconds(1));
+    max_spinners = config.busy_poll_max_spinners > 0
+        ? config.busy_poll_max_spinners
+        : (std::max)(1, static_cast<int>(std::thread::hardware_concurrency()) / 2);
+}
+
+void BusyPoll::Adaptive::onHit() {
+    current = (std::min)(current * 2, budget);
+}
+
+void BusyPoll::Adaptive::onMiss() {
+    current = (std::max)(current / 2, floor);
+}
+
+bool BusyPoll::enter() {
+    int now = spinners.fetch_add(1, std::memory_order_relaxed);
+    if (now < max_spinners) return true;
+    spinners.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+}
+
+void BusyPoll::leave() {
+    spinners.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int BusyPoll::recv(SOCKET socket, char* buffer, int length, Adaptive& adaptive) {
+    if (active) {
+        // FIONREAD asks the stack without sleeping; once data is there the
+        // blocking recv below returns immediately
+        spin(adaptive, [socket] {
+            u_long available = 0;
+            return ioctlsocket(socket, FIONREAD, &available) != 0 || available > 0;
+        });
+    }
+    return ::recv(socket, buffer, length, 0);
+}
+
+// Winsock has no SO_BUSY_POLL; the loopback fast path is the closest knob
+// and covers the co-located case this mode targets
+void BusyPoll::tuneListener(SOCKET socket) {
+    if (!active) return;
+    int enable = 1;
+    DWORD bytes = 0;
+    WSAIoctl(socket, SIO_LOOPBACK_FAST_PATH, &enable, sizeof(enable), nullptr, 0, &bytes, nullptr, nullptr);
+}
@@ -6,103 +6,732 @@
  ****************************************************/
 
 #include "../../include/ClientAuthInc/client_handler.hpp"
+#include "../../include/ClientAuthInc/auth_service.hpp"
+#include "../../include/ClientAuthInc/busy_poll.hpp"
+#include "../../include/ClientAuthInc/compression.hpp"
+#include "../../include/ClientAuthInc/flood_control.hpp"
+#include "../../include/ClientAuthInc/history_index.hpp"
+#include "../../include/ClientAuthInc/output_coalescer.hpp"
+#include "../../include/ClientAuthInc/overload_controller.hpp"
+#include "../../include/ContentFilter.hpp"
+#include "../../include/TrafficCapture.hpp"
+#include "../../include/ThreadPlacement.hpp"
 
 namespace {
 	// Constants
     constexpr int BUFFER_SIZE = 4096;
+    constexpr int MAX_DEFERRALS = 5;                // an optional command waits at most this many delays
+    constexpr std::chrono::seconds DEFER_DELAY{ 1 };
     std::unordered_map<int, std::shared_ptr<Client>> clients;
     std::mutex clients_mutex;
 
+    // Auth deadlines, idle disconnects and heartbeats all share one wheel
+    ServerConfig config;
+    std::unique_ptr<TimerService> timers;
+
+    // Moderation stage in front of every broadcast and direct message
+    ContentFilter content_filter;
+
+    // Recent room messages, searchable with /search
+    std::unique_ptr<HistoryIndex> history;
+
+    // Sessions of dropped clients, waiting to be resumed
+    SessionStore sessions;
+    const std::string RESUME_SUFFIX = " +resume";
+    const std::string DEFLATE_SUFFIX = " +deflate";
+
+    // Rate limits on room messages; null until configured
+    std::unique_ptr<FloodControl> flood;
+
+    // Password checks; null when no credential file is configured
+    std::unique_ptr<AuthService> auth;
+
+    // Recording of inbound sessions for replay; closed unless configured
+    TrafficCapture::Writer capture;
+    std::atomic<std::uint32_t> next_capture_session{ 1 };
+
+    // Sections of the /stats report, registered once at startup
+    std::vector<std::pair<std::string, std::function<std::string()>>> stats_sources;   // by name, in order
+    std::mutex stats_mutex;
+
 	// Function to send a message to a socket
     void sendToSocket(int fd, const std::string& msg) {
         send(fd, msg.c_str(), static_cast<int>(msg.size()), 0);
     }
 
+    // Source address of a connection, as the key for login lockouts
+    std::string peerAddress(int fd) {
+        sockaddr_in addr{};
+        int len = sizeof(addr);
+        char text[INET_ADDRSTRLEN] = "";
+        if (getpeername(fd, (sockaddr*)&addr, &len) != 0
+            || !inet_ntop(AF_INET, &addr.sin_addr, text, sizeof(text)))
+            return "unknown";
+        return text;
+    }
+
+    // One batch as the client's deflate stream. Consecutive messages with
+    // the same room accounting end in one flush, so each room is charged
+    // exactly the bytes sent for it.
+    std::string deflateBatch(Compression::Stream& stream, const std::vector<OutboundMessage>& batch) {
+        std::string wire;
+        std::size_t i = 0;
+        while (i < batch.size()) {
+            auto start = std::chrono::steady_clock::now();
+            const auto& room_stats = batch[i].room_stats;
+            std::size_t plain = 0;
+            for (; i < batch.size() && batch[i].room_stats == room_stats; ++i) {
+                const OutboundMessage& msg = batch[i];
+                plain += msg.text.size();
+                if (msg.frame) stream.insert(*msg.frame, msg.text);
+                else if (!msg.compress) stream.store(msg.text);
+                else stream.compress(msg.text);
+            }
+            std::string out = stream.take();
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            Compression::noteSent(room_stats.get(), plain, out.size(), static_cast<std::uint64_t>(micros));
+            wire += out;
+        }
+        return wire;
+    }
+
     void clientWriter(std::shared_ptr<Client> client) {
-        std::string msg;
+        std::vector<std::string> batch;
+        std::vector<OutboundMessage> to_deflate;   // instead of `batch` for compressing clients
+        std::size_t batch_bytes = 0;
+        BusyPoll::Adaptive spin;
+        OutputCoalescer coalescer;
+        // End of the last send; time a message waited before this was spent
+        // blocked on the client's own socket, not on a busy server
+        std::chrono::steady_clock::time_point writer_free{};
+
+        auto waiting = [&] { return !client->message_queue.empty() || client->closed; };
+        // Moves everything queued into the outgoing batch (queue_mutex held)
+        auto takeQueued = [&] {
+            if (OverloadController::tracking() && !client->message_queue.empty())
+                OverloadController::noteSojourn((std::max)(client->head_enqueued, writer_free));
+            std::size_t taken = 0;
+            while (!client->message_queue.empty()) {
+                OutboundMessage& msg = client->message_queue.front();
+                batch_bytes += msg.text.size();
+                if (client->deflater)
+                    to_deflate.push_back(std::move(msg));
+                else
+                    batch.push_back(std::move(msg.text));
+                client->message_queue.pop();
+                ++taken;
+            }
+            client->pending.fetch_sub(taken, std::memory_order_relaxed);
+            coalescer.noteArrivals(taken);
+        };
+
         while (true) {
+            // Low-latency mode: spin briefly first, a message arriving now
+            // then costs neither a wake-up nor a context switch
+            BusyPoll::spin(spin, [&] { return client->pending.load(std::memory_order_acquire) > 0; });
+
             // Wait for a message to be available in the queue
             std::unique_lock<std::mutex> lock(client->queue_mutex);
-            client->queue_cv.wait(lock, [&] { return !client->message_queue.empty(); });
+            client->writer_parked = true;
+            client->queue_cv.wait(lock, waiting);
 
-            if (client->socket_fd == INVALID_SOCKET) break;
+            if (client->closed) break;
+            takeQueued();
 
-			// Process all messages in the queue
-            while (!client->message_queue.empty()) {
-                msg = client->message_queue.front();
-                client->message_queue.pop();
-				// Unlock the mutex while sending to avoid deadlock
-                lock.unlock();
-                sendToSocket(client->socket_fd, msg);
-                lock.lock();
+            // Under load, give the batch a bounded window to fill up to one
+            // segment; at light load it goes out immediately
+            if (coalescer.shouldHold()) {
+                auto deadline = std::chrono::steady_clock::now() + OutputCoalescer::window();
+                while (batch_bytes < OutputCoalescer::flushBytes()
+                    && client->queue_cv.wait_until(lock, deadline, waiting) && !client->closed) {
+                    takeQueued();
+                }
             }
+            client->writer_parked = false;
+
+			// Unlock the mutex while sending to avoid deadlock
+            lock.unlock();
+            if (client->deflater) {
+                batch.push_back(deflateBatch(*client->deflater, to_deflate));
+                to_deflate.clear();
+            }
+            if (client->deliver)
+                client->deliver(batch);
+            else
+                OutputCoalescer::send(client->socket_fd, batch);
+            writer_free = std::chrono::steady_clock::now();
+            batch.clear();
+            batch_bytes = 0;
+        }
+    }
+
+    // Forces a disconnect; the reader wakes from recv() and runs cleanupClient
+    void dropConnection(const std::shared_ptr<Client>& client, const std::string& reason) {
+        // Plain text in the middle of a deflate stream would only garble it
+        if (!client->deflater) sendToSocket(client->socket_fd, reason);
+        shutdown(client->socket_fd, SD_BOTH);
+        if (client->abort) {
+            client->aborted = true;
+            client->abort();
         }
     }
+
+    // Runs the text through the block list; returns false if it must not be
+    // delivered, otherwise leaves the (possibly masked) text in place
+    bool moderate(const std::shared_ptr<Client>& client, std::string& text) {
+        if (!content_filter.enabled()) return true;
+
+        ContentFilter::Result result = content_filter.apply(text);
+        if (result.action == ContentFilter::Action::Reject) {
+            client->enqueueMessage("Message rejected by content filter.\n");
+            return false;
+        }
+        if (result.flagged)
+            std::cout << "Content filter: flagged message from " << client->username << ": " << text << std::endl;
+        text = std::move(result.text);
+        return true;
+    }
+
+    // Rate limits a room message before it reaches the fan-out. An overdraft
+    // is paid for on this reader thread, so a flooding client stops being
+    // read and TCP pushes back on it; a larger one costs the line, and
+    // repeated drops the connection.
+    bool admitRoomMessage(const std::shared_ptr<Client>& client, std::size_t bytes) {
+        if (!flood || !flood->enabled() || client->current_room.empty()) return true;
+        // Bots on this host (LocalTransport; only they have `deliver`) are
+        // trusted traffic at rates no person types
+        if (config.flood_exempt_local && client->deliver) return true;
+
+        FloodControl::Verdict verdict = flood->check(client->flood, client->current_room, bytes);
+        switch (verdict.action) {
+        case FloodControl::Action::Delay:
+            std::this_thread::sleep_for(verdict.delay);
+            return true;
+        case FloodControl::Action::Drop:
+            client->enqueueMessage("Slow down: message dropped.\n");
+            return false;
+        case FloodControl::Action::Disconnect:
+            dropConnection(client, "Disconnected: flooding\n");
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    // Picks up edits to the word list and credentials without a restart
+    void scheduleReloads() {
+        timers->schedule(config.reload_interval, [] {
+            content_filter.reloadIfChanged();
+            if (auth) auth->reloadIfChanged();
+            scheduleReloads();
+        });
+    }
+
+    // Only listed users may watch rooms they have not joined, and only after
+    // proving it with a password: without one, anyone could take the name
+    bool isMonitor(const std::shared_ptr<Client>& client) {
+        if (client->password_verified
+            && std::find(config.monitor_users.begin(), config.monitor_users.end(), client->username)
+            != config.monitor_users.end())
+            return true;
+        client->enqueueMessage("Subscriptions are limited to monitoring accounts with a password.\n");
+        return false;
+    }
+
+    // Forgets idle rooms' budgets now and then
+    void scheduleFloodSweep() {
+        timers->schedule(std::chrono::seconds(60), [] {
+            flood->sweep();
+            scheduleFloodSweep();
+        });
+    }
+
+    // While the server sheds load, optional commands wait on the timer
+    // wheel; after MAX_DEFERRALS delays they run regardless
+    void runWhenCalm(const std::shared_ptr<Client>& client, std::function<void(std::shared_ptr<Client>)> command,
+        int attempts = 0) {
+        if (!OverloadController::shedding() || attempts >= MAX_DEFERRALS) {
+            command(client);
+            return;
+        }
+        if (attempts == 0) OverloadController::noteDeferred();
+        std::weak_ptr<Client> weak = client;
+        timers->schedule(DEFER_DELAY, [weak, command = std::move(command), attempts] {
+            auto client = weak.lock();
+            if (client && !client->isClosed()) runWhenCalm(client, command, attempts + 1);
+        });
+    }
+
+    // Starts recording a client that has just logged in
+    void captureLogin(const std::shared_ptr<Client>& client) {
+        if (!capture.isOpen()) return;
+        client->capture_session = next_capture_session.fetch_add(1, std::memory_order_relaxed);
+        capture.login(client->capture_session, client->username);
+    }
+
+    void scheduleCaptureFlush() {
+        timers->schedule(std::chrono::seconds(1), [] {
+            capture.flush();
+            scheduleCaptureFlush();
+        });
+    }
+
+    // Strips a login option such as " +resume" off the end of the name
+    bool takeOption(std::string& username, const std::string& suffix) {
+        if (username.size() <= suffix.size() || !username.ends_with(suffix)) return false;
+        username.erase(username.size() - suffix.size());
+        return true;
+    }
+
+    // The last-seen part of "/resume": a bare "<seq>" for the active room,
+    // or "<room>=<seq>,..." for any of them. Malformed entries are skipped,
+    // and those rooms replay from the disconnect.
+    std::unordered_map<std::string, std::uint64_t> parseLastSeen(const std::string& arg,
+        const std::string& current_room) {
+        auto number = [](const std::string& digits, std::uint64_t& value) {
+            if (digits.empty() || digits.size() > 19 || digits.find_first_not_of("0123456789") != std::string::npos)
+                return false;
+            value = std::stoull(digits);
+            return true;
+        };
+
+        std::unordered_map<std::string, std::uint64_t> last_seen;
+        std::uint64_t seq = 0;
+        if (number(arg, seq)) {
+            if (!current_room.empty()) last_seen[current_room] = seq;
+            return last_seen;
+        }
+        std::istringstream items(arg);
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            std::size_t equals = item.rfind('=');
+            if (equals == 0 || equals == std::string::npos || !number(item.substr(equals + 1), seq)) continue;
+            last_seen[item.substr(0, equals)] = seq;
+        }
+        return last_seen;
+    }
+
+    // Sends a prompt and reads one line, without its line ending
+    std::string promptLine(int fd, const std::string& prompt) {
+        char buffer[BUFFER_SIZE];
+        sendToSocket(fd, prompt);
+        int len = recv(fd, buffer, BUFFER_SIZE - 1, 0);
+        if (len <= 0) return "";
+
+        std::string line(buffer, len);
+        line.erase(line.find_last_not_of("\r\n") + 1);
+        return line;
+    }
+
+    // Fires once the client could have gone idle; re-arms for the remainder
+    // if it has spoken since, so traffic never has to touch the wheel
+    void scheduleIdleCheck(const std::shared_ptr<Client>& client, std::chrono::milliseconds delay) {
+        std::weak_ptr<Client> weak = client;
+        client->idle_timer = timers->schedule(delay, [weak] {
+            auto client = weak.lock();
+            if (!client || client->isClosed()) return;
+
+            auto limit = std::chrono::duration_cast<std::chrono::milliseconds>(config.idle_timeout);
+            auto idle = client->idleFor();
+            if (idle >= limit)
+                dropConnection(client, "Disconnected: idle timeout\n");
+            else
+                scheduleIdleCheck(client, limit - idle);
+        });
+    }
+
+    // Sends PING to a quiet client and drops it if nothing comes back in time
+    void scheduleHeartbeat(const std::shared_ptr<Client>& client, std::chrono::milliseconds delay) {
+        std::weak_ptr<Client> weak = client;
+        client->heartbeat_timer = timers->schedule(delay, [weak] {
+            auto client = weak.lock();
+            if (!client || client->isClosed()) return;
+
+            auto interval = std::chrono::duration_cast<std::chrono::milliseconds>(config.heartbeat_interval);
+            auto idle = client->idleFor();
+            if (idle < interval) {
+                scheduleHeartbeat(client, interval - idle);
+            }
+            else if (!client->awaiting_pong.exchange(true)) {
+                client->enqueueMessage("PING\n");
+                scheduleHeartbeat(client, config.heartbeat_timeout);
+            }
+            else {
+                dropConnection(client, "Disconnected: heartbeat timeout\n");
+            }
+        });
+    }
 }
 
-std::string ClientHandler::authenticateClient(int client_fd) {
-    char buffer[BUFFER_SIZE];
-    sendToSocket(client_fd, "Enter your username: ");
-    int len = recv(client_fd, buffer, BUFFER_SIZE - 1, 0);
-    if (len <= 0) return "";
+void ClientHandler::configure(const ServerConfig& server_config) {
+    config = server_config;
+    RoomManager::configure(config);
+    BusyPoll::configure(config);
+    OutputCoalescer::configure(config);
+    OverloadController::configure(config);
+    Compression::configure(config);
+    if (timers) timers->stop();
+    timers = std::make_unique<TimerService>(config.timer_tick);
+    timers->start();
 
-    buffer[len] = '\0';
-    std::string username(buffer);
-    username.erase(username.find_last_not_of(" \r\n") + 1);
+    if (!config.filter_wordlist.empty())
+        content_filter.load(config.filter_wordlist);
+    ClientHandler::addStatsSource("filter", [] { return content_filter.report(); });
+    ClientHandler::addStatsSource("overload", OverloadController::report);
+    ClientHandler::addStatsSource("compression", Compression::report);
+
+    auth.reset();
+    if (!config.credential_file.empty()) {
+        auto store = std::make_unique<FileCredentialStore>();
+        store->load(config.credential_file);
+        auth = std::make_unique<AuthService>(std::move(store), config);
+        ClientHandler::addStatsSource("auth", [] { return auth ? auth->report() : std::string(); });
+    }
+    if (!config.filter_wordlist.empty() || auth)
+        scheduleReloads();
+    if (!config.monitor_users.empty() && !auth)
+        std::cerr << "monitor_users needs a credential_file; /subscribe is refused to everyone" << std::endl;
+
+    flood = std::make_unique<FloodControl>(config);
+    if (flood->enabled()) {
+        ClientHandler::addStatsSource("flood", [] { return flood->report(); });
+        scheduleFloodSweep();
+    }
+
+    if (!config.capture_file.empty()) {
+        if (capture.open(config.capture_file))
+            scheduleCaptureFlush();
+        else
+            std::cerr << "Cannot open capture file " << config.capture_file << std::endl;
+    }
+
+    history = std::make_unique<HistoryIndex>(config);
+    ClientHandler::addStatsSource("history", [] { return history->report(); });
+    ClientHandler::addStatsSource("sessions", [] { return sessions.report(); });
+}
+
+std::string ClientHandler::authenticateClient(int client_fd) {
+    std::string username = promptLine(client_fd, "Enter your username: ");
+    username.erase(username.find_last_not_of(' ') + 1);
     return username;
 }
 
-std::shared_ptr<Client> ClientHandler::registerClient(int client_fd, const std::string& username) {
-    auto client = std::make_shared<Client>(client_fd);
+// The hash runs on the auth pool; this thread only waits for the answer,
+// so a login storm queues there instead of eating every core
+bool ClientHandler::checkPassword(int client_fd, const std::string& username) {
+    std::string password = promptLine(client_fd, "Password: ");
+    if (password.empty()) return false;
+
+    auto outcome = auth->verify(username, password, peerAddress(client_fd));
+    if (outcome.wait_for(config.auth_timeout) != std::future_status::ready) {
+        sendToSocket(client_fd, "Login is taking too long, try again later.\n");
+        return false;
+    }
+    switch (outcome.get()) {
+    case AuthService::Outcome::Accepted:
+        return true;
+    case AuthService::Outcome::Throttled:
+        sendToSocket(client_fd, "Too many failed attempts, try again later.\n");
+        return false;
+    case AuthService::Outcome::Busy:
+        sendToSocket(client_fd, "Server busy, try again shortly.\n");
+        return false;
+    default:
+        sendToSocket(client_fd, "Invalid username or password.\n");
+        return false;
+    }
+}
+
+// Registers the client under its username; fails if the name is taken
+bool ClientHandler::registerClient(std::shared_ptr<Client> client, const std::string& username) {
+    if (!UserDirectory::claim(username, client)) return false;
     client->username = username;
 
     std::lock_guard<std::mutex> lock(clients_mutex);
-    clients[client_fd] = client;
-    return client;
+    clients[client->socket_fd] = client;
+    return true;
+}
+
+// "/resume <token> [<last-seq> | <room>=<seq>,...]" in place of a username:
+// restores the parked session and replays the room messages the client missed
+bool ClientHandler::resumeSession(std::shared_ptr<Client> client, const std::string& input) {
+    std::istringstream iss(input);
+    std::string cmd, token, seen_arg;
+    iss >> cmd >> token >> seen_arg;
+
+    auto session = sessions.resume(token);
+    if (!session) {
+        sendToSocket(client->socket_fd, "Resume failed: unknown or expired token.\n");
+        return false;
+    }
+    timers->cancel(session->expiry);
+    if (!ClientHandler::registerClient(client, session->username)) {
+        RoomManager::releaseDetached(*session, clients_mutex);
+        sendToSocket(client->socket_fd, "Resume failed: username '" + session->username + "' is now taken.\n");
+        return false;
+    }
+
+    client->resume_token = token;
+    client->sequence_tags = true;
+    client->password_verified = session->password_verified;
+    sendToSocket(client->socket_fd, "Welcome back, " + session->username + "!\n");
+    RoomManager::resumeRooms(*session, parseLastSeen(seen_arg, session->current_room),
+        client->socket_fd, client, clients_mutex);
+    return true;
+}
+
+// Keeps the rooms (and their sequences) for resume_grace; whichever comes
+// first, a resume or the expiry timer, takes the session. The session is
+// parked before its timer exists, so even a tiny grace cannot fire early.
+void ClientHandler::parkSession(std::shared_ptr<Client> client) {
+    std::string token = client->resume_token;
+    SessionStore::Session session;
+    session.username = client->username;
+    session.password_verified = client->password_verified;
+    RoomManager::detachClient(client->socket_fd, client, clients_mutex, session);
+    sessions.park(token, std::move(session));
+
+    auto expiry = timers->schedule(config.resume_grace, [token] {
+        auto expired = sessions.expire(token);
+        if (expired) RoomManager::releaseDetached(*expired, clients_mutex);
+    });
+    // Resumed in between: the timer must not outlive the session, or it
+    // could expire this token's next one
+    if (!sessions.setExpiry(token, expiry)) timers->cancel(expiry);
 }
 
 void ClientHandler::handleClientCommands(std::shared_ptr<Client> client) {
     char buffer[BUFFER_SIZE];
     int client_fd = client->socket_fd;
+    BusyPoll::Adaptive spin;
 
     while (true) {
-        int len = recv(client_fd, buffer, BUFFER_SIZE - 1, 0);
+        int len = BusyPoll::recv(client_fd, buffer, BUFFER_SIZE - 1, spin);
         if (len <= 0) break;
+        if (!ClientHandler::processInput(client, std::string_view(buffer, len))) break;
+    }
+}
 
-        buffer[len] = '\0';
-        std::string input(buffer);
-        input.erase(input.find_last_not_of(" \r\n") + 1);
-
-        if (input == "/quit") break;
-        else if (input.compare(0, 5, "/join") == 0)
-            RoomManager::joinRoom(input, client_fd, client, clients_mutex, clients);
-        else if (input == "/leave")
-            RoomManager::leaveRoom(client_fd, client, clients_mutex);
-        else if (input == "/rooms")
-            RoomManager::listRooms(client);
-        else
-            RoomManager::broadcastMessage(input, client_fd, client, clients_mutex, clients);
+// One line from any transport; false when the client asked to quit
+bool ClientHandler::processInput(std::shared_ptr<Client> client, std::string_view raw) {
+    int client_fd = client->socket_fd;
+    if (client->capture_session) capture.line(client->capture_session, raw);
+
+    // Drops control characters and repairs malformed UTF-8 in one pass
+    std::string input = ContentFilter::sanitize(raw);
+    input.erase(input.find_last_not_of(" \t") + 1);
+    client->touch();
+
+    if (input == "/quit") return false;
+    else if (input == "/pong") return true; // liveness already recorded
+    else if (input.compare(0, 5, "/join") == 0)
+        RoomManager::joinRoom(input, client_fd, client, clients_mutex, clients);
+    else if (input.compare(0, 7, "/leave ") == 0 || input == "/leave")
+        RoomManager::leaveRoom(input, client_fd, client, clients_mutex);
+    else if (input.compare(0, 7, "/rooms ") == 0 || input == "/rooms")
+        runWhenCalm(client, [input](std::shared_ptr<Client> client) { RoomManager::listRooms(input, client); });
+    else if (input.compare(0, 5, "/msg ") == 0 || input == "/msg")
+        ClientHandler::sendDirectMessage(input, client);
+    else if (input == "/stats")
+        ClientHandler::sendStats(client);
+    else if (input.compare(0, 8, "/search ") == 0 || input == "/search")
+        history->search(input, client, clients_mutex);
+    else if (input.compare(0, 11, "/subscribe ") == 0 || input == "/subscribe") {
+        if (isMonitor(client)) RoomManager::subscribe(input, client_fd, client, clients_mutex);
+    }
+    else if (input.compare(0, 13, "/unsubscribe ") == 0 || input == "/unsubscribe")
+        RoomManager::unsubscribe(input, client_fd, client, clients_mutex);
+    else if (input == "/subscriptions")
+        RoomManager::listSubscriptions(client, clients_mutex);
+    else if (admitRoomMessage(client, input.size()) && moderate(client, input)) {
+        RoomManager::broadcastMessage(input, client_fd, client, clients_mutex, clients);
+        // current_room only changes on this thread, so this is the room just used
+        if (!client->current_room.empty())
+            history->add(client->current_room, client->username + ": " + input);
+    }
+    return true;
+}
+
+bool ClientHandler::loginLocal(std::shared_ptr<Client> client, const std::string& username,
+    const std::string& password, std::string& error) {
+    if (auth) {
+        auto outcome = password.empty()
+            ? std::future<AuthService::Outcome>() : auth->verify(username, password, "local");
+        if (!outcome.valid() || outcome.wait_for(config.auth_timeout) != std::future_status::ready
+            || outcome.get() != AuthService::Outcome::Accepted) {
+            error = "authentication failed";
+            return false;
+        }
+    }
+    if (!ClientHandler::registerClient(client, username)) {
+        error = "username '" + username + "' is already taken";
+        return false;
     }
+    client->password_verified = auth != nullptr;
+    captureLogin(client);
+    return true;
+}
+
+// Local sessions skip the idle and heartbeat timers: the transport notices
+// a vanished bot by its setup socket closing
+void ClientHandler::serveLocal(std::shared_ptr<Client> client, const std::function<bool(std::string&)>& next_line) {
+    std::thread writer([client] { clientWriter(client); });
+    writer.detach();
+
+    std::string line;
+    while (!client->aborted && !client->isClosed() && next_line(line) && ClientHandler::processInput(client, line)) {}
+    ClientHandler::cleanupClient(client);
+}
+
+// Delivers straight to the target's outbound queue; no room state involved
+void ClientHandler::sendDirectMessage(const std::string& input, std::shared_ptr<Client> client) {
+    std::istringstream iss(input);
+    std::string cmd, target_name, text;
+    iss >> cmd >> target_name;
+    std::getline(iss >> std::ws, text);
+    if (target_name.empty() || text.empty()) {
+        client->enqueueMessage("Usage: /msg <user> <text>\n");
+        return;
+    }
+
+    auto target = UserDirectory::find(target_name);
+    if (!target) {
+        client->enqueueMessage("No such user: " + target_name + "\n");
+        return;
+    }
+    if (!moderate(client, text)) return;
+    target->enqueueMessage("[DM] " + client->username + ": " + text + "\n");
+}
+
+// A second configure (or a second Server) replaces the section it
+// registered before instead of repeating it
+void ClientHandler::addStatsSource(const std::string& name, std::function<std::string()> source) {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    for (auto& [existing, report] : stats_sources) {
+        if (existing == name) {
+            report = std::move(source);
+            return;
+        }
+    }
+    stats_sources.emplace_back(name, std::move(source));
+}
+
+void ClientHandler::sendStats(std::shared_ptr<Client> client) {
+    std::string report;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        for (const auto& [name, source] : stats_sources) report += source();
+    }
+    client->enqueueMessage(report.empty() ? "No statistics available.\n" : report);
 }
 
 void ClientHandler::cleanupClient(std::shared_ptr<Client> client) {
     int fd = client->socket_fd;
-    RoomManager::leaveRoom(fd, client, clients_mutex);
-    client->socket_fd = INVALID_SOCKET;
+    if (client->capture_session) capture.close(client->capture_session);
+    timers->cancel(client->idle_timer);
+    timers->cancel(client->heartbeat_timer);
 
-    std::lock_guard<std::mutex> lock(clients_mutex);
-    clients.erase(fd);
+    // The name goes first: a /resume arriving as soon as the session is
+    // parked must be able to claim it again
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex);
+        clients.erase(fd);
+    }
+    UserDirectory::release(client->username, client.get());
+    if (!client->resume_token.empty())
+        ClientHandler::parkSession(client);
+    else
+        RoomManager::removeClient(fd, client, clients_mutex);
+    // Stop the writer; the socket is closed when the last reference goes away
+    client->close();
 }
 
 void ClientHandler::handleClient(int client_fd) {
-    std::string username = ClientHandler::authenticateClient(client_fd);
+    // The Client owns the socket from here on, so every exit path closes it.
+    // The Client object (not its string and queue buffers) is allocated on
+    // this thread's NUMA node; with placement enabled the thread is already
+    // pinned next to the connection's RSS queue.
+    auto client = std::allocate_shared<Client>(NumaAllocator<Client>(), client_fd);
+    std::weak_ptr<Client> weak = client;
+    auto auth_timer = timers->schedule(config.auth_timeout, [weak] {
+        if (auto pending = weak.lock()) dropConnection(pending, "\nAuthentication timed out\n");
+    });
+
+    // Keep prompting until the client picks a free name or resumes a
+    // session (or the deadline hits)
+    std::string username;
+    bool resumed = false;
+    bool wants_deflate = false;
+    while (true) {
+        username = ClientHandler::authenticateClient(client_fd);
+        if (username.empty()) break;
+        if (username.compare(0, 8, "/resume ") == 0) {
+            resumed = ClientHandler::resumeSession(client, username);
+            if (resumed) {
+                username = client->username;
+                break;
+            }
+            continue;
+        }
+
+        // "<name> +resume" asks for a resume token and sequence-tagged
+        // messages, "<name> +deflate" for compressed output; in any order
+        bool wants_resume = false;
+        wants_deflate = false;
+        while (true) {
+            if (takeOption(username, RESUME_SUFFIX)) wants_resume = true;
+            else if (takeOption(username, DEFLATE_SUFFIX)) wants_deflate = true;
+            else break;
+        }
+
+        if (username.find(' ') != std::string::npos)
+            sendToSocket(client_fd, "Usernames cannot contain spaces.\n");
+        else if (auth && !ClientHandler::checkPassword(client_fd, username))
+            continue; // checkPassword has told the client why
+        else if (ClientHandler::registerClient(client, username)) {
+            client->password_verified = auth != nullptr; // checkPassword passed above
+            if (wants_resume && config.resume_grace.count() > 0) {
+                client->resume_token = SessionStore::newToken();
+                client->sequence_tags = true;
+            }
+            break;
+        }
+        else
+            sendToSocket(client_fd, "Username '" + username + "' is already taken.\n");
+    }
+    timers->cancel(auth_timer);
     if (username.empty()) return;
+    captureLogin(client);
 
-    auto client = ClientHandler::registerClient(client_fd, username);
-	std::thread writer(clientWriter, client); // defined in anonymous namespace
+    // Sent before the writer starts, so nothing queued meanwhile (a /msg,
+    // say) can get ahead of them; after the compression line the client
+    // reads a deflate stream
+    if (!resumed) {
+        sendToSocket(client_fd, "Welcome, " + username + "!\n");
+        if (!client->resume_token.empty())
+            sendToSocket(client_fd, "Resume token: " + client->resume_token + "\n");
+        if (wants_deflate) {
+            auto stream = Compression::available() ? std::make_unique<Compression::Stream>() : nullptr;
+            if (stream && stream->ok()) {
+                sendToSocket(client_fd, "Compression: deflate, window " + std::to_string(Compression::windowBits()) + " bits\n");
+                client->deflater = std::move(stream);
+            }
+            else
+                sendToSocket(client_fd, "Compression: off\n");
+        }
+    }
+	std::thread writer([client, core = ThreadPlacement::pinnedCore()] {
+        ThreadPlacement::pinCurrentThread(core); // stay next to the reader
+        clientWriter(client); // defined in anonymous namespace
+    });
     writer.detach();
 
-    sendToSocket(client_fd, "Welcome, " + username + "!\n");
+    client->touch();
+    scheduleIdleCheck(client, config.idle_timeout);
+    if (config.heartbeat_enabled)
+        scheduleHeartbeat(client, config.heartbeat_interval);
+
     ClientHandler::handleClientCommands(client);
     ClientHandler::cleanupClient(client);
 }
@@ -0,0 +1,256 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : compression.cpp
+ * Description : Optional deflate compression of outbound traffic,
+                 negotiated per connection at login
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/compression.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifdef CHAT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+bool Compression::enabled = false;
+int Compression::level = 6;
+int Compression::window_bits = 12;
+int Compression::mem_level = 5;
+std::size_t Compression::shared_minimum = 2;
+std::unordered_set<std::string> Compression::rooms;
+std::mutex Compression::stats_mutex;
+std::map<std::string, std::shared_ptr<Compression::RoomStats>> Compression::room_stats;
+std::shared_ptr<Compression::RoomStats> Compression::other_rooms = std::make_shared<RoomStats>();
+std::mutex Compression::encoders_mutex;
+std::vector<std::unique_ptr<Compression::Stream>> Compression::idle_encoders;
+std::atomic<std::int64_t> Compression::streams{ 0 };
+std::atomic<std::uint64_t> Compression::plain_bytes{ 0 };
+std::atomic<std::uint64_t> Compression::wire_bytes{ 0 };
+std::atomic<std::uint64_t> Compression::micros_spent{ 0 };
+std::atomic<std::uint64_t> Compression::frames{ 0 };
+std::atomic<std::uint64_t> Compression::frame_deliveries{ 0 };
+
+void Compression::configure(const ServerConfig& config) {
+#ifdef CHAT_HAVE_ZLIB
+    enabled = config.compression;
+#else
+    enabled = false;
+#endif
+    level = (std::clamp)(config.compression_level, 0, 9);
+    // Raw deflate does not accept an 8-bit window
+    window_bits = (std::clamp)(config.compression_window_bits, 9, 15);
+    mem_level = (std::clamp)(config.compression_mem_level, 1, 9);
+    shared_minimum = config.compression_shared_min > 0 ? config.compression_shared_min : 1;
+    rooms = std::unordered_set<std::string>(config.compression_rooms.begin(), config.compression_rooms.end());
+}
+
+bool Compression::enabledFor(const std::string& room) {
+    return rooms.empty() || rooms.count(room) > 0;
+}
+
+std::shared_ptr<Compression::RoomStats> Compression::roomStats(const std::string& room) {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    auto it = room_stats.find(room);
+    if (it != room_stats.end()) return it->second;
+    if (room_stats.size() >= MAX_ROOM_STATS) return other_rooms;
+    return room_stats.emplace(room, std::make_shared<RoomStats>()).first->second;
+}
+
+std::shared_ptr<const std::string> Compression::sharedFrame(std::string_view text, RoomStats& stats,
+    std::size_t recipients) {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<Stream> encoder;
+    {
+        std::lock_guard<std::mutex> lock(encoders_mutex);
+        if (!idle_encoders.empty()) {
+            encoder = std::move(idle_encoders.back());
+            idle_encoders.pop_back();
+        }
+    }
+    if (!encoder) encoder = std::make_unique<Stream>(false);
+    if (!encoder->ok()) return nullptr;
+    // Emptied before every message: a frame starts from an empty window
+    encoder->reset();
+    encoder->compress(text);
+    auto frame = std::make_shared<const std::string>(encoder->take());
+    {
+        std::lock_guard<std::mutex> lock(encoders_mutex);
+        if (idle_encoders.size() < MAX_IDLE_ENCODERS) idle_encoders.push_back(std::move(encoder));
+    }
+
+    auto micros = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    // Bytes are counted by each recipient's writer; the work only here
+    stats.micros.fetch_add(micros, std::memory_order_relaxed);
+    micros_spent.fetch_add(micros, std::memory_order_relaxed);
+    frames.fetch_add(1, std::memory_order_relaxed);
+    frame_deliveries.fetch_add(recipients, std::memory_order_relaxed);
+    return frame;
+}
+
+void Compression::noteSent(RoomStats* room, std::size_t plain, std::size_t wire, std::uint64_t micros) {
+    plain_bytes.fetch_add(plain, std::memory_order_relaxed);
+    wire_bytes.fetch_add(wire, std::memory_order_relaxed);
+    micros_spent.fetch_add(micros, std::memory_order_relaxed);
+    if (!room) return;
+    room->plain.fetch_add(plain, std::memory_order_relaxed);
+    room->wire.fetch_add(wire, std::memory_order_relaxed);
+    room->micros.fetch_add(micros, std::memory_order_relaxed);
+}
+
+namespace {
+    // "1234 -> 567 bytes (54% saved), 12 ms"
+    std::string savings(std::uint64_t plain, std::uint64_t wire, std::uint64_t micros) {
+        std::ostringstream out;
+        out << plain << " -> " << wire << " bytes";
+        if (plain > 0)
+            out << " (" << static_cast<long long>((static_cast<double>(plain) - static_cast<double>(wire)) * 100
+                / static_cast<double>(plain)) << "% saved)";
+        out << ", " << micros / 1000 << " ms";
+        return out.str();
+    }
+}
+
+// The five rooms that saved the most, to decide where compression pays off
+std::string Compression::report() {
+    if (!enabled) return "";
+    std::ostringstream out;
+    out << "Compression: " << streams.load(std::memory_order_relaxed) << " streams, "
+        << savings(plain_bytes.load(std::memory_order_relaxed), wire_bytes.load(std::memory_order_relaxed),
+            micros_spent.load(std::memory_order_relaxed))
+        << ", " << frames.load(std::memory_order_relaxed) << " shared frames for "
+        << frame_deliveries.load(std::memory_order_relaxed) << " deliveries\n";
+
+    struct Row {
+        std::string room;
+        std::uint64_t plain, wire, micros;
+        double saved() const { return static_cast<double>(plain) - static_cast<double>(wire); }
+    };
+    std::vector<Row> rows;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        for (const auto& [room, stats] : room_stats)
+            rows.push_back({ room, stats->plain.load(std::memory_order_relaxed),
+                stats->wire.load(std::memory_order_relaxed), stats->micros.load(std::memory_order_relaxed) });
+    }
+    if (other_rooms->plain.load(std::memory_order_relaxed) > 0)
+        rows.push_back({ "(other rooms)", other_rooms->plain.load(std::memory_order_relaxed),
+            other_rooms->wire.load(std::memory_order_relaxed), other_rooms->micros.load(std::memory_order_relaxed) });
+
+    std::size_t shown = (std::min)(rows.size(), std::size_t{ 5 });
+    std::partial_sort(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(shown), rows.end(),
+        [](const Row& a, const Row& b) { return a.saved() > b.saved(); });
+    for (std::size_t i = 0; i < shown; ++i) {
+        out << "  " << rows[i].room << (enabledFor(rows[i].room) ? "" : " (stored)") << ": "
+            << savings(rows[i].plain, rows[i].wire, rows[i].micros) << "\n";
+    }
+    return out.str();
+}
+
+#ifdef CHAT_HAVE_ZLIB
+
+Compression::Stream::Stream(bool connection) {
+    auto fresh = std::make_unique<z_stream>();
+    if (deflateInit2(fresh.get(), level, Z_DEFLATED, -window_bits, mem_level, Z_DEFAULT_STRATEGY) != Z_OK)
+        return;
+    stream = fresh.release();
+    counted = connection;
+    if (counted) streams.fetch_add(1, std::memory_order_relaxed);
+}
+
+Compression::Stream::~Stream() {
+    if (!stream) return;
+    deflateEnd(stream);
+    delete stream;
+    if (counted) streams.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Compression::Stream::run(std::string_view input, int flush) {
+    char buffer[16384];
+    stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream->avail_in = static_cast<uInt>(input.size());
+    do {
+        stream->next_out = reinterpret_cast<Bytef*>(buffer);
+        stream->avail_out = sizeof(buffer);
+        deflate(stream, flush);
+        out.append(buffer, sizeof(buffer) - stream->avail_out);
+    } while (stream->avail_out == 0);
+}
+
+void Compression::Stream::compress(std::string_view text) {
+    if (!stream || text.empty()) return;
+    run(text, Z_NO_FLUSH);
+    unflushed = true;
+}
+
+// Z_SYNC_FLUSH ends on a byte boundary with nothing left buffered: the
+// point where frames can be spliced in and deflateSetDictionary is allowed
+void Compression::Stream::flush() {
+    if (!unflushed) return;
+    run({}, Z_SYNC_FLUSH);
+    unflushed = false;
+}
+
+// The client's window now ends with `text`; so must ours, or later back
+// references would point at the wrong bytes
+void Compression::Stream::remember(std::string_view text) {
+    if (text.empty()) return;
+    deflateSetDictionary(stream, reinterpret_cast<const Bytef*>(text.data()), static_cast<uInt>(text.size()));
+}
+
+void Compression::Stream::insert(std::string_view frame, std::string_view text) {
+    if (!stream) return;
+    flush();
+    out.append(frame);
+    remember(text);
+}
+
+// Non-final stored blocks of at most 65535 bytes each
+void Compression::Stream::store(std::string_view text) {
+    if (!stream) return;
+    flush();
+    std::string_view rest = text;
+    while (!rest.empty()) {
+        std::size_t len = (std::min)(rest.size(), std::size_t{ 0xFFFF });
+        out.push_back('\0');
+        out.push_back(static_cast<char>(len & 0xFF));
+        out.push_back(static_cast<char>(len >> 8));
+        out.push_back(static_cast<char>(~len & 0xFF));
+        out.push_back(static_cast<char>((~len >> 8) & 0xFF));
+        out.append(rest.substr(0, len));
+        rest.remove_prefix(len);
+    }
+    remember(text);
+}
+
+std::string Compression::Stream::take() {
+    if (stream) flush();
+    return std::exchange(out, std::string());
+}
+
+void Compression::Stream::reset() {
+    if (!stream) return;
+    deflateReset(stream);
+    out.clear();
+    unflushed = false;
+}
+
+#else
+
+// Without zlib no stream is ever ok(), and available() keeps clients from
+// asking for one
+Compression::Stream::Stream(bool) {}
+Compression::Stream::~Stream() {}
+void Compression::Stream::compress(std::string_view) {}
+void Compression::Stream::insert(std::string_view, std::string_view) {}
+void Compression::Stream::store(std::string_view) {}
+std::string Compression::Stream::take() { return std::exchange(out, std::string()); }
+void Compression::Stream::reset() {}
+
+#endif
@@ -0,0 +1,89 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : connection_limiter.cpp
+ * Description : Admission control for the accept loop: a global connection
+                 cap and per-source-IP token buckets
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/connection_limiter.hpp"
+
+#include <algorithm>
+
+ConnectionLimiter::ConnectionLimiter(int max_connections, double per_ip_rate, double per_ip_burst,
+    std::size_t table_size)
+    : max_connections(max_connections),
+      rate_per_ms(static_cast<float>(per_ip_rate / 1000.0)),
+      burst(static_cast<float>(per_ip_burst)),
+      origin(std::chrono::steady_clock::now()) {
+    // Round the table up to a power of two so probing is a mask, not a modulo
+    std::size_t capacity = 64;
+    shift = 26;
+    while (capacity < table_size && shift > 1) {
+        capacity <<= 1;
+        --shift;
+    }
+    table.resize(capacity);
+    mask = static_cast<std::uint32_t>(capacity - 1);
+}
+
+ConnectionLimiter::Verdict ConnectionLimiter::admit(std::uint32_t ipv4) {
+    // Global cap first: it is a single atomic and rejects without hashing
+    if (active.load(std::memory_order_relaxed) >= max_connections) {
+        ++rejected_full;
+        return Verdict::RejectFull;
+    }
+
+    std::uint32_t now_ms = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - origin).count());
+    Bucket& bucket = lookup(ipv4, now_ms);
+    bucket.tokens = refilled(bucket, now_ms);
+    bucket.last_ms = now_ms;
+    if (bucket.tokens < 1.0f) {
+        ++rejected_rate;
+        return Verdict::RejectRate;
+    }
+    bucket.tokens -= 1.0f;
+
+    active.fetch_add(1, std::memory_order_relaxed);
+    return Verdict::Admit;
+}
+
+void ConnectionLimiter::release() {
+    active.fetch_sub(1, std::memory_order_relaxed);
+}
+
+float ConnectionLimiter::refilled(const Bucket& bucket, std::uint32_t now_ms) const {
+    // Unsigned subtraction keeps working across the 49-day wrap of last_ms
+    std::uint32_t elapsed = now_ms - bucket.last_ms;
+    return (std::min)(burst, bucket.tokens + static_cast<float>(elapsed) * rate_per_ms);
+}
+
+// Open addressing with a short linear probe. When the window is full the
+// entry that has been quiet longest is recycled; a bucket that has refilled
+// completely carries no state, so evicting it loses nothing.
+ConnectionLimiter::Bucket& ConnectionLimiter::lookup(std::uint32_t ip, std::uint32_t now_ms) {
+    std::uint32_t key = ip ? ip : 1; // 0 marks empty; 0.0.0.0 never connects
+    // Fibonacci hashing: take the high bits, which mix every octet of the address
+    std::uint32_t start = (key * 2654435761u) >> shift;
+
+    // Preference for reuse: empty slot, then a fully refilled one, then the oldest
+    Bucket* victim = nullptr;
+    int victim_rank = -1;
+    for (int probe = 0; probe < MAX_PROBE; ++probe) {
+        Bucket& slot = table[(start + probe) & mask];
+        if (slot.ip == key) return slot;
+
+        int rank = slot.ip == 0 ? 2 : (refilled(slot, now_ms) >= burst ? 1 : 0);
+        if (rank > victim_rank
+            || (rank == victim_rank && now_ms - slot.last_ms > now_ms - victim->last_ms)) {
+            victim = &slot;
+            victim_rank = rank;
+        }
+    }
+
+    victim->ip = key;
+    victim->tokens = burst;
+    victim->last_ms = now_ms;
+    return *victim;
+}
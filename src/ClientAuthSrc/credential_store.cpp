@@ -0,0 +1,112 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : credential_store.cpp
+ * Description : Password records for login, behind a small interface so
+                 other backends can replace the local file
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/credential_store.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+namespace {
+    bool parseHex(const std::string& text, std::vector<std::uint8_t>& out) {
+        if (text.empty() || text.size() % 2 != 0) return false;
+        out.clear();
+        for (std::size_t i = 0; i < text.size(); i += 2) {
+            unsigned value = 0;
+            std::istringstream iss(text.substr(i, 2));
+            if (!(iss >> std::hex >> value)) return false;
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+        return true;
+    }
+}
+
+bool FileCredentialStore::load(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        // Remember the path anyway: the file is picked up once it appears,
+        // and until then nobody can log in
+        std::cerr << "Credentials: cannot open " << path.string() << std::endl;
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        source = path;
+        return false;
+    }
+
+    std::unordered_map<std::string, Record> loaded;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty()) continue;
+
+        std::istringstream fields(line);
+        std::string username, salt, iterations, hash;
+        std::getline(fields, username, ':');
+        std::getline(fields, salt, ':');
+        std::getline(fields, iterations, ':');
+        std::getline(fields, hash);
+
+        Record record;
+        try {
+            record.iterations = static_cast<std::uint32_t>(std::stoul(iterations));
+        }
+        catch (const std::exception&) {
+            record.iterations = 0;
+        }
+        if (username.empty() || record.iterations == 0
+            || !parseHex(salt, record.salt) || !parseHex(hash, record.hash)) {
+            std::cerr << "Credentials: skipping malformed line " << line_number << std::endl;
+            continue;
+        }
+        loaded[username] = std::move(record);
+    }
+
+    std::vector<std::uint32_t> iterations;
+    for (const auto& [username, record] : loaded) iterations.push_back(record.iterations);
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (!iterations.empty()) {
+        auto middle = iterations.begin() + static_cast<std::ptrdiff_t>(iterations.size() / 2);
+        std::nth_element(iterations.begin(), middle, iterations.end());
+        median_iterations = *middle;
+    }
+    records.swap(loaded);
+    source = path;
+    std::error_code ec;
+    loaded_at = std::filesystem::last_write_time(path, ec);
+    std::cout << "Credentials: loaded " << records.size() << " users from " << path.string() << std::endl;
+    return true;
+}
+
+std::optional<CredentialStore::Record> FileCredentialStore::lookup(const std::string& username) {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = records.find(username);
+    if (it == records.end()) return std::nullopt;
+    return it->second;
+}
+
+std::uint32_t FileCredentialStore::typicalIterations() {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return median_iterations;
+}
+
+bool FileCredentialStore::reloadIfChanged() {
+    std::filesystem::path path;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        if (source.empty()) return false;
+        std::error_code ec;
+        auto modified = std::filesystem::last_write_time(source, ec);
+        if (ec || modified == loaded_at) return false;
+        path = source;
+    }
+    return load(path);
+}
@@ -0,0 +1,136 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : fanout_pool.cpp
+ * Description : Work-stealing worker pool and serial strands used to
+                 deliver broadcasts for very large rooms
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/fanout_pool.hpp"
+#include "../../include/ThreadPlacement.hpp"
+
+namespace {
+    // Index of the pool worker running on this thread, -1 elsewhere
+    thread_local int current_worker = -1;
+}
+
+// FanoutPool
+
+FanoutPool::FanoutPool(unsigned worker_count, const std::vector<int>& cores) {
+    if (worker_count == 0) worker_count = 1;
+    for (unsigned i = 0; i < worker_count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < worker_count; ++i) {
+        int core = cores.empty() ? -1 : cores[i % cores.size()];
+        workers[i]->thread = std::thread([this, i, core] {
+            ThreadPlacement::pinCurrentThread(core);
+            run(i);
+        });
+    }
+}
+
+FanoutPool::~FanoutPool() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        running = false;
+    }
+    idle_cv.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+void FanoutPool::submit(Task task) {
+    unsigned index = current_worker >= 0
+        ? static_cast<unsigned>(current_worker)
+        : next_worker.fetch_add(1, std::memory_order_relaxed) % workerCount();
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    idle_cv.notify_one();
+}
+
+// Owner takes the oldest task so strands keep rotating fairly
+bool FanoutPool::popLocal(unsigned index, Task& out) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) return false;
+    out = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    return true;
+}
+
+// Thieves take from the other end to stay out of the owner's way
+bool FanoutPool::steal(unsigned thief, Task& out) {
+    unsigned count = workerCount();
+    for (unsigned offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        out = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void FanoutPool::run(unsigned index) {
+    current_worker = static_cast<int>(index);
+    Task task;
+    while (true) {
+        if (popLocal(index, task) || steal(index, task)) {
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_cv.wait(lock, [this] { return pending.load(std::memory_order_relaxed) > 0 || !running; });
+        if (!running) break;
+    }
+}
+
+// Strand
+
+void Strand::post(FanoutPool::Task task) {
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(task));
+        if (!scheduled) {
+            scheduled = true;
+            schedule = true;
+        }
+    }
+    if (schedule) {
+        auto self = shared_from_this();
+        pool.submit([self] { self->drain(); });
+    }
+}
+
+void Strand::drain() {
+    for (int i = 0; i < DRAIN_BUDGET; ++i) {
+        FanoutPool::Task task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.empty()) {
+                scheduled = false;
+                return;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+
+    // Budget used up: requeue behind other strands instead of hogging a worker
+    auto self = shared_from_this();
+    pool.submit([self] { self->drain(); });
+}
@@ -0,0 +1,133 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : flood_control.cpp
+ * Description : Token-bucket rate limits on room messages, per connection
+                 and per room, checked before fan-out
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/flood_control.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+FloodControl::FloodControl(const ServerConfig& config)
+    : client_messages{ config.flood_client_msgs_per_sec, config.flood_client_msg_burst },
+      client_bytes{ config.flood_client_bytes_per_sec, config.flood_client_byte_burst },
+      room_messages{ config.flood_room_msgs_per_sec, config.flood_room_msg_burst },
+      room_bytes{ config.flood_room_bytes_per_sec, config.flood_room_byte_burst },
+      max_delay(config.flood_max_delay),
+      disconnect_strikes(config.flood_disconnect_strikes),
+      strike_window(config.flood_strike_window),
+      on(client_messages.rate > 0 || client_bytes.rate > 0 || room_messages.rate > 0 || room_bytes.rate > 0) {}
+
+void FloodControl::refill(Bucket& bucket, const Limit& limit, Clock::time_point now) {
+    if (bucket.last == Clock::time_point()) {
+        bucket.tokens = limit.burst;
+    }
+    else {
+        double elapsed = std::chrono::duration<double>(now - bucket.last).count();
+        bucket.tokens = (std::min)(limit.burst, bucket.tokens + elapsed * limit.rate);
+    }
+    bucket.last = now;
+}
+
+// A line longer than the whole burst is charged the burst, or it could
+// never pass at all
+double FloodControl::waitSeconds(const Bucket& bucket, const Limit& limit, double cost) {
+    if (limit.rate <= 0) return 0.0;
+    cost = (std::min)(cost, limit.burst);
+    return bucket.tokens >= cost ? 0.0 : (cost - bucket.tokens) / limit.rate;
+}
+
+// May leave the bucket in debt; the caller's delay pays it back
+void FloodControl::take(Bucket& bucket, const Limit& limit, double cost) {
+    if (limit.rate > 0) bucket.tokens -= (std::min)(cost, limit.burst);
+}
+
+FloodControl::Verdict FloodControl::check(Budget& client, const std::string& room, std::size_t bytes) {
+    Verdict verdict;
+    if (!on) return verdict;
+
+    Clock::time_point now = Clock::now();
+    double size = static_cast<double>(bytes);
+    refill(client.messages, client_messages, now);
+    refill(client.bytes, client_bytes, now);
+    double client_wait = (std::max)(waitSeconds(client.messages, client_messages, 1.0),
+        waitSeconds(client.bytes, client_bytes, size));
+
+    // The room's buckets are shared by every sender in it; decide and charge
+    // under one lock so concurrent senders cannot both spend the last tokens
+    double limit = std::chrono::duration<double>(max_delay).count();
+    double room_wait = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(rooms_mutex);
+        Budget& shared = rooms[room];
+        refill(shared.messages, room_messages, now);
+        refill(shared.bytes, room_bytes, now);
+        room_wait = (std::max)(waitSeconds(shared.messages, room_messages, 1.0),
+            waitSeconds(shared.bytes, room_bytes, size));
+        if ((std::max)(client_wait, room_wait) <= limit) {
+            take(shared.messages, room_messages, 1.0);
+            take(shared.bytes, room_bytes, size);
+        }
+    }
+
+    double wait = (std::max)(client_wait, room_wait);
+    if (wait <= limit) {
+        take(client.messages, client_messages, 1.0);
+        take(client.bytes, client_bytes, size);
+        if (wait > 0.0) {
+            verdict.action = Action::Delay;
+            verdict.delay = std::chrono::milliseconds(static_cast<std::int64_t>(wait * 1000.0) + 1);
+            delayed.fetch_add(1, std::memory_order_relaxed);
+            delay_ms.fetch_add(static_cast<std::uint64_t>(verdict.delay.count()), std::memory_order_relaxed);
+        }
+        else {
+            passed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return verdict;
+    }
+
+    verdict.action = Action::Drop;
+    if (client_wait < room_wait) {
+        dropped_room.fetch_add(1, std::memory_order_relaxed);
+        return verdict;
+    }
+    dropped_client.fetch_add(1, std::memory_order_relaxed);
+
+    if (now - client.last_strike > strike_window) client.strikes = 0;
+    client.last_strike = now;
+    if (disconnect_strikes > 0 && ++client.strikes >= disconnect_strikes) {
+        verdict.action = Action::Disconnect;
+        disconnected.fetch_add(1, std::memory_order_relaxed);
+    }
+    return verdict;
+}
+
+void FloodControl::sweep() {
+    if (!on) return;
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(rooms_mutex);
+    for (auto it = rooms.begin(); it != rooms.end();) {
+        Budget& budget = it->second;
+        refill(budget.messages, room_messages, now);
+        refill(budget.bytes, room_bytes, now);
+        if (budget.messages.tokens >= room_messages.burst && budget.bytes.tokens >= room_bytes.burst)
+            it = rooms.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::string FloodControl::report() const {
+    if (!on) return "";
+    std::ostringstream out;
+    out << "Flood control: " << passed.load(std::memory_order_relaxed) << " passed, "
+        << delayed.load(std::memory_order_relaxed) << " delayed ("
+        << delay_ms.load(std::memory_order_relaxed) << " ms total), "
+        << dropped_client.load(std::memory_order_relaxed) << " dropped (sender over budget), "
+        << dropped_room.load(std::memory_order_relaxed) << " dropped (room over budget), "
+        << disconnected.load(std::memory_order_relaxed) << " disconnected\n";
+    return out.str();
+}
@@ -0,0 +1,346 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : history_index.cpp
+ * Description : Recent room history with an incremental inverted index,
+                 queried by /search on a background thread
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/history_index.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+namespace {
+    constexpr auto SWEEP_INTERVAL = std::chrono::seconds(1);
+
+    bool isWordByte(unsigned char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+    }
+
+    void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::uint64_t readVarint(const std::vector<std::uint8_t>& in, std::size_t& pos) {
+        std::uint64_t value = 0;
+        for (int shift = 0; pos < in.size(); shift += 7) {
+            std::uint8_t byte = in[pos++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        return value;
+    }
+}
+
+HistoryIndex::HistoryIndex(const ServerConfig& config)
+    : retention(config.history_retention),
+      max_messages((std::max)(config.history_max_messages, std::size_t{ 1 })),
+      page_size((std::max)(config.search_page_size, std::size_t{ 1 })),
+      max_results(config.search_max_results) {
+    worker = std::thread([this] { run(); });
+}
+
+HistoryIndex::~HistoryIndex() {
+    {
+        std::lock_guard<std::mutex> lock(query_mutex);
+        stopping = true;
+    }
+    query_cv.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+// Lower-cased runs of letters and digits (any non-ASCII byte counts as a
+// letter, so UTF-8 words stay whole); each term once per message
+std::vector<std::string> HistoryIndex::tokenize(const std::string& text) {
+    std::vector<std::string> terms;
+    std::size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && !isWordByte(static_cast<unsigned char>(text[i]))) ++i;
+        std::size_t start = i;
+        while (i < text.size() && isWordByte(static_cast<unsigned char>(text[i]))) ++i;
+        if (i == start) continue;
+
+        std::string term = text.substr(start, (std::min)(i - start, MAX_TERM_LENGTH));
+        for (char& c : term) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        terms.push_back(std::move(term));
+    }
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    return terms;
+}
+
+void HistoryIndex::append(Postings& postings, std::uint64_t id) {
+    if (postings.count == 0) {
+        postings.first = id;
+    }
+    else {
+        writeVarint(postings.bytes, id - postings.last);
+    }
+    postings.last = id;
+    ++postings.count;
+}
+
+// Drops the oldest entry. Eviction always removes the oldest message of the
+// room, which is therefore the first entry of every list it appears in.
+void HistoryIndex::popFront(Postings& postings) {
+    if (--postings.count == 0) {
+        postings.bytes.clear();
+        postings.head = 0;
+        return;
+    }
+    postings.first += readVarint(postings.bytes, postings.head);
+    if (postings.head > 64 && postings.head * 2 > postings.bytes.size()) {
+        postings.bytes.erase(postings.bytes.begin(), postings.bytes.begin() + postings.head);
+        postings.head = 0;
+    }
+}
+
+std::vector<std::uint64_t> HistoryIndex::decode(const Postings& postings) {
+    std::vector<std::uint64_t> ids;
+    if (postings.count == 0) return ids;
+    ids.reserve(postings.count);
+    ids.push_back(postings.first);
+    std::size_t pos = postings.head;
+    while (pos < postings.bytes.size()) {
+        ids.push_back(ids.back() + readVarint(postings.bytes, pos));
+    }
+    return ids;
+}
+
+HistoryIndex::Shard& HistoryIndex::shardFor(const std::string& room) {
+    return shards[std::hash<std::string>{}(room) % SHARD_COUNT];
+}
+
+std::shared_ptr<HistoryIndex::RoomIndex> HistoryIndex::findRoom(const std::string& room) {
+    Shard& shard = shardFor(room);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.rooms.find(room);
+    return it != shard.rooms.end() ? it->second : nullptr;
+}
+
+void HistoryIndex::add(const std::string& room, const std::string& line) {
+    if (retention.count() <= 0) return;
+
+    std::vector<std::string> terms = tokenize(line);
+    auto now = std::chrono::steady_clock::now();
+
+    // Take the room lock before letting go of the shard, so the sweeper
+    // cannot drop this room between lookup and insert
+    Shard& shard = shardFor(room);
+    std::unique_lock<std::mutex> shard_lock(shard.mutex);
+    auto& slot = shard.rooms[room];
+    if (!slot) slot = std::make_shared<RoomIndex>();
+    std::shared_ptr<RoomIndex> index = slot;
+    std::lock_guard<std::mutex> lock(index->mutex);
+    shard_lock.unlock();
+
+    std::uint64_t id = index->next_id++;
+    index->messages.push_back({ id, now, line });
+    for (const auto& term : terms) {
+        Postings& postings = index->terms[term];
+        std::size_t before = postings.bytes.size();
+        append(postings, id);
+        index->posting_bytes += postings.bytes.size() - before;
+    }
+    messages_indexed.fetch_add(1, std::memory_order_relaxed);
+    evict(*index, now);
+}
+
+// Called with the room lock held
+void HistoryIndex::evict(RoomIndex& index, std::chrono::steady_clock::time_point now) {
+    while (!index.messages.empty()
+        && (index.messages.size() > max_messages || now - index.messages.front().time > retention)) {
+        for (const auto& term : tokenize(index.messages.front().text)) {
+            auto it = index.terms.find(term);
+            if (it == index.terms.end()) continue;
+            std::size_t before = it->second.bytes.size();
+            popFront(it->second);
+            index.posting_bytes -= before - it->second.bytes.size();
+            if (it->second.count == 0) index.terms.erase(it);
+        }
+        index.messages.pop_front();
+        messages_evicted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Expires history of rooms that went quiet and forgets rooms with none left
+void HistoryIndex::sweep() {
+    auto now = std::chrono::steady_clock::now();
+    for (Shard& shard : shards) {
+        std::lock_guard<std::mutex> shard_lock(shard.mutex);
+        for (auto it = shard.rooms.begin(); it != shard.rooms.end();) {
+            std::shared_ptr<RoomIndex> index = it->second;
+            bool empty;
+            {
+                std::lock_guard<std::mutex> lock(index->mutex);
+                evict(*index, now);
+                empty = index->messages.empty();
+            }
+            // add() needs the shard lock we hold, so the room stays empty
+            it = empty ? shard.rooms.erase(it) : std::next(it);
+        }
+    }
+}
+
+void HistoryIndex::search(const std::string& input, std::shared_ptr<Client> client, std::mutex& mutex) {
+    std::istringstream iss(input);
+    std::string cmd, room, rest;
+    iss >> cmd >> room;
+    std::getline(iss, rest);
+    std::vector<std::string> terms = tokenize(rest);
+    if (room.empty() || terms.empty()) {
+        client->enqueueMessage("Usage: /search <room> <terms>\n");
+        return;
+    }
+    if (retention.count() <= 0) {
+        client->enqueueMessage("Search is disabled on this server.\n");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!client->rooms.count(room)) {
+            client->enqueueMessage("You are not in room: " + room + "\n");
+            return;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(query_mutex);
+        if (queries.size() >= MAX_PENDING_QUERIES) {
+            queries_refused.fetch_add(1, std::memory_order_relaxed);
+            client->enqueueMessage("Search is busy, try again shortly.\n");
+            return;
+        }
+        queries.push_back({ client, room, std::move(terms) });
+    }
+    query_cv.notify_one();
+}
+
+void HistoryIndex::run() {
+    auto last_sweep = std::chrono::steady_clock::now();
+    while (true) {
+        std::unique_lock<std::mutex> lock(query_mutex);
+        query_cv.wait_for(lock, SWEEP_INTERVAL, [this] { return stopping || !queries.empty(); });
+        if (stopping) break;
+
+        std::deque<Query> batch;
+        batch.swap(queries);
+        lock.unlock();
+
+        for (const auto& query : batch) execute(query);
+        if (std::chrono::steady_clock::now() - last_sweep >= SWEEP_INTERVAL) {
+            sweep();
+            last_sweep = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+// Room locks are held only to copy posting lists and, afterwards, the few
+// matching lines; decoding and intersecting run unlocked
+void HistoryIndex::execute(const Query& query) {
+    auto client = query.client.lock();
+    if (!client || client->isClosed()) return;
+    queries_served.fetch_add(1, std::memory_order_relaxed);
+
+    std::string joined;
+    for (const auto& term : query.terms) joined += (joined.empty() ? "" : " ") + term;
+    std::string none = "No messages in " + query.room + " match '" + joined + "'.\n";
+
+    auto index = findRoom(query.room);
+    if (!index) {
+        client->enqueueMessage(none);
+        return;
+    }
+
+    std::vector<Postings> lists;
+    {
+        std::lock_guard<std::mutex> lock(index->mutex);
+        for (const auto& term : query.terms) {
+            auto it = index->terms.find(term);
+            if (it == index->terms.end()) {
+                client->enqueueMessage(none);
+                return;
+            }
+            lists.push_back(it->second);
+        }
+    }
+
+    // Intersect starting from the rarest term
+    std::sort(lists.begin(), lists.end(),
+        [](const Postings& a, const Postings& b) { return a.count < b.count; });
+    std::vector<std::uint64_t> matches = decode(lists[0]);
+    for (std::size_t i = 1; i < lists.size() && !matches.empty(); ++i) {
+        std::vector<std::uint64_t> other = decode(lists[i]), both;
+        std::set_intersection(matches.begin(), matches.end(), other.begin(), other.end(),
+            std::back_inserter(both));
+        matches.swap(both);
+    }
+
+    // Newest first, capped
+    std::size_t total = matches.size();
+    if (max_results > 0 && matches.size() > max_results)
+        matches.erase(matches.begin(), matches.end() - max_results);
+    std::reverse(matches.begin(), matches.end());
+
+    std::vector<std::string> lines;
+    {
+        std::lock_guard<std::mutex> lock(index->mutex);
+        if (!index->messages.empty()) {
+            std::uint64_t oldest = index->messages.front().id;
+            for (std::uint64_t id : matches) {
+                if (id < oldest || id - oldest >= index->messages.size()) continue; // evicted meanwhile
+                lines.push_back("  #" + std::to_string(id) + " " + index->messages[id - oldest].text + "\n");
+            }
+        }
+    }
+    if (lines.empty()) {
+        client->enqueueMessage(none);
+        return;
+    }
+
+    // One outbound message per page, so long result sets interleave with
+    // live traffic instead of arriving as one block
+    std::size_t pages = (lines.size() + page_size - 1) / page_size;
+    std::string page = "Search '" + joined + "' in " + query.room + ": " + std::to_string(total)
+        + " match(es), showing " + std::to_string(lines.size()) + "\n";
+    for (std::size_t p = 0; p < pages; ++p) {
+        if (client->isClosed()) return;
+        for (std::size_t i = p * page_size; i < (std::min)(lines.size(), (p + 1) * page_size); ++i)
+            page += lines[i];
+        page += "-- page " + std::to_string(p + 1) + "/" + std::to_string(pages) + " --\n";
+        client->enqueueMessage(page);
+        page.clear();
+    }
+}
+
+std::string HistoryIndex::report() const {
+    std::size_t rooms = 0, messages = 0, terms = 0, bytes = 0;
+    for (const Shard& shard : shards) {
+        std::lock_guard<std::mutex> shard_lock(shard.mutex);
+        for (const auto& [name, index] : shard.rooms) {
+            std::lock_guard<std::mutex> lock(index->mutex);
+            ++rooms;
+            messages += index->messages.size();
+            terms += index->terms.size();
+            bytes += index->posting_bytes;
+        }
+    }
+
+    std::ostringstream out;
+    out << "History index: " << rooms << " rooms, " << messages << " messages, "
+        << terms << " terms, " << bytes << " posting bytes; "
+        << messages_indexed.load(std::memory_order_relaxed) << " indexed, "
+        << messages_evicted.load(std::memory_order_relaxed) << " evicted, "
+        << queries_served.load(std::memory_order_relaxed) << " searches, "
+        << queries_refused.load(std::memory_order_relaxed) << " refused\n";
+    return out.str();
+}
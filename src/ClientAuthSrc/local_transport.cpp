@@ -0,0 +1,177 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : local_transport.cpp
+ * Description : Transport for bots on the same host: session setup over a
+                 Unix domain socket, messages over shared-memory rings
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/local_transport.hpp"
+#include "../../include/ClientAuthInc/client_handler.hpp"
+#include "../../include/SharedRing.hpp"
+#include "../../include/ThreadPlacement.hpp"
+
+#include <afunix.h>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    constexpr std::size_t MAX_HELLO = 512;
+    constexpr DWORD HELLO_TIMEOUT_MS = 5000;        // a silent connection is dropped after this
+    constexpr DWORD FULL_RING_RETRY_MS = 50;
+
+    void sendLine(SOCKET socket, const std::string& line) {
+        send(socket, line.c_str(), static_cast<int>(line.size()), 0);
+    }
+
+    // The handshake is one short line; read up to its newline, or whatever
+    // arrived before the deadline
+    std::string readLine(SOCKET socket) {
+        DWORD timeout = HELLO_TIMEOUT_MS;
+        setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+        std::string line;
+        char c;
+        while (line.size() < MAX_HELLO && recv(socket, &c, 1, 0) == 1) {
+            if (c == '\n') break;
+            if (c != '\r') line += c;
+        }
+        return line;
+    }
+}
+
+LocalTransport::LocalTransport(const ServerConfig& config)
+    : path(config.local_socket_path), ring_bytes(config.local_ring_bytes) {}
+
+LocalTransport::~LocalTransport() {
+    running = false;
+    if (listener != INVALID_SOCKET) closesocket(listener);
+    if (acceptor.joinable()) acceptor.join();
+}
+
+bool LocalTransport::start() {
+    SOCKADDR_UN addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Local transport: socket path too long: " << path << std::endl;
+        return false;
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET) {
+        std::cerr << "Local transport: AF_UNIX not supported on this system" << std::endl;
+        return false;
+    }
+    // A socket file left over from a previous run would make bind fail
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR
+        || listen(listener, SOMAXCONN) == SOCKET_ERROR) {
+        std::cerr << "Local transport: cannot listen on " << path << std::endl;
+        closesocket(listener);
+        listener = INVALID_SOCKET;
+        return false;
+    }
+
+    running = true;
+    acceptor = std::thread([this] { acceptLoop(); });
+    std::cout << "Local transport listening on " << path << std::endl;
+    return true;
+}
+
+void LocalTransport::acceptLoop() {
+    while (running) {
+        SOCKET socket = accept(listener, nullptr, nullptr);
+        if (socket == INVALID_SOCKET) continue; // listener closed on shutdown, or a transient error
+        try {
+            std::thread([this, socket] { serve(socket); }).detach();
+        }
+        catch (const std::system_error& e) {
+            std::cerr << "Local transport: thread creation failed: " << e.what() << std::endl;
+            closesocket(socket);
+        }
+    }
+}
+
+void LocalTransport::serve(SOCKET socket) {
+    std::istringstream hello(readLine(socket));
+    std::string verb, username, password;
+    hello >> verb >> username >> password;
+    if (verb != "HELLO" || username.empty()) {
+        sendLine(socket, "ERR expected HELLO <username> [password]\n");
+        closesocket(socket);
+        return;
+    }
+
+    // Unguessable, so no other process can create or open it first
+    std::string name = "chat-" + SessionStore::newToken();
+    std::shared_ptr<SharedRingPair> rings = SharedRingPair::create(name, ring_bytes);
+    if (!rings) {
+        sendLine(socket, "ERR cannot create shared memory\n");
+        closesocket(socket);
+        return;
+    }
+
+    // From here the Client owns the socket
+    auto client = std::allocate_shared<Client>(NumaAllocator<Client>(), socket);
+    std::string error;
+    if (!ClientHandler::loginLocal(client, username, password, error)) {
+        sendLine(socket, "ERR " + error + "\n");
+        return;
+    }
+
+    // Outbound lines are copied straight into the bot's ring. A full ring
+    // holds up this bot's writer only; a line that can never fit is dropped.
+    auto alive = std::make_shared<std::atomic<bool>>(true);
+    client->deliver = [this, rings, alive](const std::vector<std::string>& batch) {
+        SharedRing& ring = rings->outbound();
+        for (const auto& message : batch) {
+            bool pushed = message.size() <= ring.maxMessage() && ring.push(message);
+            while (!pushed && message.size() <= ring.maxMessage() && *alive && !ring.corrupt()) {
+                ring.waitWritable(message.size(), FULL_RING_RETRY_MS);
+                pushed = ring.push(message);
+            }
+            (pushed ? messages_out : messages_dropped).fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    sendLine(socket, "RING " + name + " " + std::to_string(rings->outbound().capacity()) + "\n");
+    sessions.fetch_add(1, std::memory_order_relaxed);
+
+    // The bot is gone once the socket closes; wait on that alongside the ring.
+    // A server-side drop signals the same event, and it may come from any
+    // thread at any time, so the event lives as long as the Client needs it.
+    std::shared_ptr<void> closed_event(WSACreateEvent(), [](void* event) { WSACloseEvent(event); });
+    WSAEventSelect(socket, closed_event.get(), FD_CLOSE);
+    client->abort = [closed_event] { WSASetEvent(closed_event.get()); };
+    auto next_line = [&](std::string& line) {
+        SharedRing& ring = rings->inbound();
+        while (!ring.pop(line)) {
+            if (client->aborted) return false;
+            if (ring.corrupt()) {
+                std::cerr << "Local transport: malformed frame from " << username << ", closing" << std::endl;
+                return false;
+            }
+            if (ring.waitReadable(INFINITE, closed_event.get()) == SharedRing::Wait::Other) {
+                if (client->aborted || !ring.pop(line)) return false; // one last look for lines sent before closing
+                break;
+            }
+        }
+        messages_in.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    };
+    ClientHandler::serveLocal(client, next_line);
+
+    *alive = false;
+}
+
+std::string LocalTransport::report() const {
+    std::ostringstream out;
+    out << "Local transport: " << sessions.load(std::memory_order_relaxed) << " sessions, "
+        << messages_in.load(std::memory_order_relaxed) << " lines in, "
+        << messages_out.load(std::memory_order_relaxed) << " lines out, "
+        << messages_dropped.load(std::memory_order_relaxed) << " dropped (too long or bot gone)\n";
+    return out.str();
+}
@@ -0,0 +1,91 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : room_directory.cpp
+ * Description : Sorted room list with member counts, kept up to date on
+                 join/leave and served a page at a time for /rooms
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/room_directory.hpp"
+
+#include <algorithm>
+
+void RoomDirectory::configure(const ServerConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex);
+    page_size = config.rooms_page_size > 0 ? config.rooms_page_size : 1;
+    refresh = config.rooms_refresh;
+    ++version;
+}
+
+void RoomDirectory::update(const std::string& room, std::size_t members) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = rooms.try_emplace(room, members);
+    if (!inserted) {
+        if (it->second == members) return;
+        it->second = members;
+    }
+    ++version;
+}
+
+void RoomDirectory::remove(const std::string& room) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (rooms.erase(room)) ++version;
+}
+
+// The copy is the only O(rooms) step, and it runs at most once per refresh
+// interval however many queries arrive
+std::shared_ptr<const RoomDirectory::Snapshot> RoomDirectory::current() {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto now = std::chrono::steady_clock::now();
+    if (snapshot->version != version && now - built_at >= refresh) {
+        auto fresh = std::make_shared<Snapshot>();
+        fresh->version = version;
+        fresh->rooms.assign(rooms.begin(), rooms.end());
+        snapshot = std::move(fresh);
+        built_at = now;
+    }
+    return snapshot;
+}
+
+std::string RoomDirectory::query(std::string_view prefix, std::size_t page) {
+    std::shared_ptr<const Snapshot> snap = current();
+    std::string key = std::to_string(page) + " " + std::string(prefix);
+    {
+        std::lock_guard<std::mutex> lock(snap->pages_mutex);
+        auto it = snap->pages.find(key);
+        if (it != snap->pages.end()) return it->second;
+    }
+
+    std::string text = render(*snap, prefix, page);
+    std::lock_guard<std::mutex> lock(snap->pages_mutex);
+    if (snap->pages.size() >= MAX_CACHED_PAGES) snap->pages.clear();
+    snap->pages.emplace(std::move(key), text);
+    return text;
+}
+
+std::string RoomDirectory::render(const Snapshot& snap, std::string_view prefix, std::size_t page) const {
+    auto by_name = [](const std::pair<std::string, std::size_t>& entry, std::string_view name) {
+        return std::string_view(entry.first) < name;
+    };
+    auto first = std::lower_bound(snap.rooms.begin(), snap.rooms.end(), prefix, by_name);
+    // The prefix range ends at the first name that no longer starts with it
+    auto last = prefix.empty() ? snap.rooms.end()
+        : std::partition_point(first, snap.rooms.end(), [prefix](const auto& entry) {
+            return std::string_view(entry.first).substr(0, prefix.size()) == prefix;
+        });
+
+    std::size_t matches = static_cast<std::size_t>(last - first);
+    std::size_t pages = matches == 0 ? 1 : (matches + page_size - 1) / page_size;
+    if (page < 1) page = 1;
+    if (page > pages) return "No such page (" + std::to_string(pages) + " in total).\n";
+
+    std::string text = "Active rooms";
+    if (!prefix.empty()) text += " starting with '" + std::string(prefix) + "'";
+    text += " (" + std::to_string(matches) + ", page " + std::to_string(page) + "/" + std::to_string(pages) + "):\n";
+    auto it = first + static_cast<std::ptrdiff_t>((page - 1) * page_size);
+    for (std::size_t i = 0; i < page_size && it != last; ++i, ++it)
+        text += "- " + it->first + " (" + std::to_string(it->second) + " users)\n";
+    if (page < pages)
+        text += "More: /rooms " + (prefix.empty() ? std::string() : std::string(prefix) + " ") + std::to_string(page + 1) + "\n";
+    return text;
+}
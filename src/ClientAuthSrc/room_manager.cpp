@@ -6,6 +6,48 @@
  ****************************************************/
 
 #include "../../include/ClientAuthInc/room_manager.hpp"
+#include "../../include/ClientAuthInc/overload_controller.hpp"
+
+#include <algorithm>
+#include <thread>
+
+std::unordered_map<std::string, RoomManager::Room> RoomManager::chat_rooms;
+std::unordered_map<std::string, RoomManager::Draining> RoomManager::draining;
+std::unique_ptr<FanoutPool> RoomManager::fanout_pool;
+std::size_t RoomManager::fanout_threshold = 0;
+std::size_t RoomManager::fanout_partitions = 1;
+std::size_t RoomManager::backlog_limit = 0;
+SubscriptionTrie RoomManager::subscriptions;
+std::vector<int> RoomManager::matched;
+std::size_t RoomManager::max_rooms = 16;
+RoomDirectory RoomManager::directory;
+
+void RoomManager::configure(const ServerConfig& config) {
+    fanout_threshold = config.fanout_threshold;
+    fanout_partitions = config.fanout_partitions > 0 ? config.fanout_partitions : 1;
+    backlog_limit = config.resume_grace.count() > 0 ? config.resume_backlog : 0;
+    max_rooms = config.max_rooms_per_client > 0 ? config.max_rooms_per_client : 1;
+    directory.configure(config);
+    unsigned workers = config.fanout_workers > 0
+        ? config.fanout_workers : (std::max)(1u, std::thread::hardware_concurrency());
+    fanout_pool = fanout_threshold > 0 ? std::make_unique<FanoutPool>(workers, config.worker_cores) : nullptr;
+}
+
+// Socket handles are often multiples of 4, so mix the bits before reducing
+std::size_t RoomManager::partitionOf(int client_fd) {
+    return ((static_cast<std::uint32_t>(client_fd) * 2654435761u) >> 16) % fanout_partitions;
+}
+
+const std::string& RoomManager::Outgoing::forRecipient(const Client& recipient, bool label) const {
+    if (label) return recipient.sequence_tags ? labelled_tagged : labelled;
+    return recipient.sequence_tags ? tagged : plain;
+}
+
+OutboundMessage RoomManager::Outgoing::to(const Client& recipient, bool label) const {
+    const std::string& text = forRecipient(recipient, label);
+    if (!stats) return OutboundMessage(text);
+    return OutboundMessage(text, &text == &plain ? frame : nullptr, compress, stats);
+}
 
 void RoomManager::joinRoom(const std::string& input, int client_fd, std::shared_ptr<Client> client,
     std::mutex& mutex,
@@ -19,55 +61,365 @@ void RoomManager::joinRoom(const std::string& input, int client_fd, std::shared_
     }
 
     std::lock_guard<std::mutex> lock(mutex);
-    if (!client->current_room.empty())
-        RoomManager::chat_rooms[client->current_room].erase(client_fd);
+    if (client->rooms.count(room)) {
+        client->current_room = room;
+        client->enqueueMessage("Switched to room: " + room + "\n");
+        return;
+    }
+    if (max_rooms == 1 && !client->current_room.empty()) {
+        std::string old_room = client->current_room;
+        removeMember(old_room, client_fd, *client);
+        eraseIfUnused(old_room);
+    }
+    else if (client->rooms.size() >= max_rooms) {
+        client->enqueueMessage("You are in " + std::to_string(max_rooms) + " rooms already; /leave one first.\n");
+        return;
+    }
 
+    client->rooms.insert(room);
+    client->multi_room = client->rooms.size() > 1;
     client->current_room = room;
-    RoomManager::chat_rooms[room].insert(client_fd);
+    Room& new_room = roomNamed(room);
+    new_room.members.insert(client_fd);
+    if (client->deflater) ++new_room.compressing;
+    new_room.snapshot.reset();
+    directory.update(room, new_room.members.size());
     client->enqueueMessage("Joined room: " + room + "\n");
 }
 
 // Function to handle a client leaving a room
-void RoomManager::leaveRoom(int client_fd, std::shared_ptr<Client> client, std::mutex& mutex) {
+void RoomManager::leaveRoom(const std::string& input, int client_fd, std::shared_ptr<Client> client,
+    std::mutex& mutex) {
+    std::istringstream iss(input);
+    std::string cmd, room;
+    iss >> cmd >> room;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (room.empty()) room = client->current_room;
+    if (room.empty()) return;
+    if (!client->rooms.count(room)) {
+        client->enqueueMessage("You are not in room: " + room + "\n");
+        return;
+    }
+
+    removeMember(room, client_fd, *client);
+    client->enqueueMessage("Left room: " + room + "\n");
+    // Leaving the active room makes another joined room active, if any
+    if (client->current_room == room) {
+        client->current_room = client->rooms.empty() ? "" : *client->rooms.begin();
+        if (!client->current_room.empty())
+            client->enqueueMessage("Now talking in: " + client->current_room + "\n");
+    }
+
+    // Clean up the room if it's empty
+    eraseIfUnused(room);
+}
+
+void RoomManager::removeClient(int client_fd, std::shared_ptr<Client> client, std::mutex& mutex) {
     std::lock_guard<std::mutex> lock(mutex);
+    dropMemberships(client_fd, *client, "");
+    client->current_room = "";
+}
 
-    if (!client->current_room.empty()) {
-		// Remove the client from the current room
-        std::string room = client->current_room;
-        RoomManager::chat_rooms[room].erase(client_fd);
-		// If the client was the last one in the room, notify them
-        client->enqueueMessage("Left room: " + room + "\n");
-        client->current_room = "";
-
-        // Clean up the room if it's empty
-        if (RoomManager::chat_rooms[room].empty()) {
-            RoomManager::chat_rooms.erase(room);
+// Called with the clients mutex held; current_room is left to the caller
+void RoomManager::removeMember(const std::string& room, int client_fd, Client& client) {
+    auto it = chat_rooms.find(room);
+    if (it != chat_rooms.end()) {
+        if (it->second.members.erase(client_fd) && client.deflater) --it->second.compressing;
+        it->second.snapshot.reset();
+        directory.update(room, it->second.members.size());
+    }
+    client.rooms.erase(room);
+    client.multi_room = client.rooms.size() > 1;
+}
+
+// Called with the clients mutex held: leaves every room but `keep` and
+// drops the client's subscriptions
+void RoomManager::dropMemberships(int client_fd, Client& client, const std::string& keep) {
+    std::vector<std::string> leaving(client.rooms.begin(), client.rooms.end());
+    for (const auto& room : leaving) {
+        if (room == keep) continue;
+        removeMember(room, client_fd, client);
+        eraseIfUnused(room);
+    }
+    for (const auto& pattern : client.subscriptions) subscriptions.remove(pattern, client_fd);
+    client.subscriptions.clear();
+}
+
+// Called with the clients mutex held; creates the room if needed
+RoomManager::Room& RoomManager::roomNamed(const std::string& room) {
+    auto [it, created] = chat_rooms.try_emplace(room);
+    if (created) {
+        auto old = draining.find(room);
+        if (old != draining.end()) {
+            it->second.strands = std::move(old->second.strands);
+            it->second.in_flight = std::move(old->second.in_flight);
+            draining.erase(old);
         }
     }
+    return it->second;
+}
+
+// Called with the clients mutex held
+void RoomManager::eraseIfUnused(const std::string& room) {
+    auto it = chat_rooms.find(room);
+    if (it != chat_rooms.end() && it->second.members.empty() && it->second.detached == 0) {
+        // Forget rooms that finished draining meanwhile, then park this one's
+        // strands if it has not
+        std::erase_if(draining, [](const auto& entry) { return entry.second.in_flight->load() == 0; });
+        if (it->second.in_flight->load() > 0)
+            draining[room] = { std::move(it->second.strands), it->second.in_flight };
+        chat_rooms.erase(it);
+        directory.remove(room);
+    }
+}
+
+void RoomManager::subscribe(const std::string& input, int client_fd, std::shared_ptr<Client> client,
+    std::mutex& mutex) {
+    std::istringstream iss(input);
+    std::string cmd, pattern;
+    iss >> cmd >> pattern;
+    if (!SubscriptionTrie::validPattern(pattern)) {
+        client->enqueueMessage("Usage: /subscribe <pattern>, e.g. support.* or *\n");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (subscriptions.add(pattern, client_fd))
+        client->subscriptions.push_back(pattern);
+    client->enqueueMessage("Subscribed: " + pattern + "\n");
+}
+
+void RoomManager::unsubscribe(const std::string& input, int client_fd, std::shared_ptr<Client> client,
+    std::mutex& mutex) {
+    std::istringstream iss(input);
+    std::string cmd, pattern;
+    iss >> cmd >> pattern;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find(client->subscriptions.begin(), client->subscriptions.end(), pattern);
+    if (it == client->subscriptions.end()) {
+        client->enqueueMessage("Not subscribed: " + pattern + "\n");
+        return;
+    }
+    subscriptions.remove(pattern, client_fd);
+    client->subscriptions.erase(it);
+    client->enqueueMessage("Unsubscribed: " + pattern + "\n");
 }
 
-void RoomManager::listRooms(std::shared_ptr<Client> client) {
-    std::string msg = "Active rooms:\n";
-    for (const auto& pair : chat_rooms) {
-        msg += "- " + pair.first + " (" + std::to_string(pair.second.size()) + " users)\n";
+void RoomManager::listSubscriptions(std::shared_ptr<Client> client, std::mutex& mutex) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (client->subscriptions.empty()) {
+        client->enqueueMessage("No subscriptions.\n");
+        return;
     }
+    std::string msg = "Subscriptions:\n";
+    for (const auto& pattern : client->subscriptions) msg += "- " + pattern + "\n";
     client->enqueueMessage(msg);
 }
 
+void RoomManager::detachClient(int client_fd, std::shared_ptr<Client> client, std::mutex& mutex,
+    SessionStore::Session& session) {
+    std::lock_guard<std::mutex> lock(mutex);
+    session.current_room = client->current_room;
+    session.subscriptions = client->subscriptions;
+    std::vector<std::string> leaving(client->rooms.begin(), client->rooms.end());
+    for (const auto& name : leaving) {
+        Room& room = roomNamed(name);
+        ++room.detached;
+        session.rooms.emplace_back(name, room.last_seq);
+        removeMember(name, client_fd, *client);
+    }
+    dropMemberships(client_fd, *client, "");
+    client->current_room = "";
+}
+
+void RoomManager::releaseDetached(const SessionStore::Session& session, std::mutex& mutex) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : session.rooms) {
+        auto it = chat_rooms.find(entry.first);
+        if (it == chat_rooms.end()) continue;
+        if (it->second.detached > 0) --it->second.detached;
+        eraseIfUnused(entry.first);
+    }
+}
+
+// Replays under the same lock broadcasts take, so nothing sent after the
+// replay can overtake it
+void RoomManager::resumeRooms(const SessionStore::Session& session,
+    const std::unordered_map<std::string, std::uint64_t>& last_seen, int client_fd,
+    std::shared_ptr<Client> client, std::mutex& mutex) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : session.rooms) {
+        Room& room = roomNamed(entry.first);
+        if (room.detached > 0) --room.detached;
+        room.members.insert(client_fd);
+        if (client->deflater) ++room.compressing;
+        room.snapshot.reset();
+        directory.update(entry.first, room.members.size());
+        client->rooms.insert(entry.first);
+    }
+    client->multi_room = client->rooms.size() > 1;
+    client->current_room = session.current_room;
+    for (const auto& pattern : session.subscriptions) {
+        if (subscriptions.add(pattern, client_fd)) client->subscriptions.push_back(pattern);
+    }
+
+    // Replayed lines look like live ones, "[room]" included for a client in several rooms
+    for (const auto& [name, detached_seq] : session.rooms) {
+        const Room& room = chat_rooms.at(name);
+        auto seen = last_seen.find(name);
+        std::uint64_t last_seq = seen != last_seen.end() ? seen->second : detached_seq;
+
+        std::uint64_t missed = room.last_seq > last_seq ? room.last_seq - last_seq : 0;
+        std::uint64_t available = 0;
+        for (const auto& line : room.backlog) {
+            if (line.first > last_seq) ++available;
+        }
+        std::string status = "Resumed room: " + name + " (" + std::to_string(missed) + " missed";
+        if (seen == last_seen.end()) status += " since the disconnect";
+        if (available < missed)
+            status += ", " + std::to_string(missed - available) + " no longer available";
+        client->enqueueMessage(status + ")\n");
+
+        std::string label = client->multi_room ? "[" + name + "] " : "";
+        for (const auto& line : room.backlog) {
+            if (line.first > last_seq)
+                client->enqueueMessage("#" + std::to_string(line.first) + " " + label + line.second);
+        }
+    }
+    if (!client->current_room.empty() && client->multi_room)
+        client->enqueueMessage("Now talking in: " + client->current_room + "\n");
+}
+
+void RoomManager::listRooms(const std::string& input, std::shared_ptr<Client> client) {
+    std::istringstream iss(input);
+    std::string cmd, prefix, page_arg;
+    iss >> cmd >> prefix >> page_arg;
+    // A lone number is a page, not a prefix
+    if (page_arg.empty() && !prefix.empty() && prefix.find_first_not_of("0123456789") == std::string::npos)
+        std::swap(prefix, page_arg);
+
+    std::size_t page = 1;
+    if (!page_arg.empty()) {
+        if (page_arg.size() > 9 || page_arg.find_first_not_of("0123456789") != std::string::npos) {
+            client->enqueueMessage("Usage: /rooms [prefix] [page]\n");
+            return;
+        }
+        page = std::stoul(page_arg);
+    }
+    client->enqueueMessage(directory.query(prefix, page));
+}
+
 void RoomManager::broadcastMessage(const std::string& input, int client_fd,
     std::shared_ptr<Client> client,
     std::mutex& mutex,
     std::unordered_map<int, std::shared_ptr<Client>>& clients) {
-    std::lock_guard<std::mutex> lock(mutex);
+    // current_room only changes on this (the sender's reader) thread
     if (client->current_room.empty()) {
         client->enqueueMessage("Join a room with /join <room> first.\n");
         return;
     }
+    const std::string& room_name = client->current_room;
+    auto msg = std::make_shared<Outgoing>();
+    msg->plain = client->username + ": " + input + "\n";
+
+    // With enough compressing members the plain text is compressed once
+    // for all of them instead of by each of their writers (see Compression).
+    // That happens here, outside the clients mutex; the member count it
+    // goes by may be a message out of date, which only decides who does
+    // the compressing.
+    if (Compression::activeStreams() > 0) {
+        std::shared_ptr<Compression::RoomStats> stats;
+        std::size_t compressing = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = chat_rooms.find(room_name);
+            if (it != chat_rooms.end() && it->second.compressing > 0) {
+                if (!it->second.compression) it->second.compression = Compression::roomStats(room_name);
+                stats = it->second.compression;
+                compressing = it->second.compressing;
+            }
+        }
+        if (stats && compressing >= Compression::sharedMinimum() && Compression::enabledFor(room_name))
+            msg->frame = Compression::sharedFrame(msg->plain, *stats, compressing);
+    }
 
-    std::string full_msg = client->username + ": " + input + "\n";
-    for (int fd : RoomManager::chat_rooms[client->current_room]) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Room& room = roomNamed(room_name);
+    std::uint64_t seq = ++room.last_seq;
+    msg->tagged = "#" + std::to_string(seq) + " " + msg->plain;
+    msg->labelled = "[" + room_name + "] " + msg->plain;
+    msg->labelled_tagged = "#" + std::to_string(seq) + " " + msg->labelled;
+    if (backlog_limit > 0) {
+        room.backlog.emplace_back(seq, msg->plain);
+        if (room.backlog.size() > backlog_limit) room.backlog.pop_front();
+    }
+
+    if (room.compressing > 0) {
+        if (!room.compression) room.compression = Compression::roomStats(room_name);
+        msg->stats = room.compression;
+        msg->compress = Compression::enabledFor(room_name);
+    }
+
+    // Monitors that are not members get their copy here, in the same order
+    // as the room's members. One trie walk per message, whatever the number
+    // of subscriptions. Under load they only get a sample (OverloadController).
+    matched.clear();
+    if (subscriptions.size() > 0 && OverloadController::sampleMonitor(seq))
+        subscriptions.match(room_name, matched);
+    for (int fd : matched) {
+        if (fd == client_fd || room.members.count(fd)) continue;
+        auto it = clients.find(fd);
+        if (it != clients.end()) it->second->enqueueMessage(msg->to(*it->second, true));
+    }
+
+    // Large rooms go to the worker pool. A room that still has chunks in
+    // flight stays on that path even if it shrank, or the inline copy could
+    // overtake them.
+    if (fanout_pool && (room.members.size() >= fanout_threshold || room.in_flight->load() > 0)) {
+        parallelBroadcast(room, std::move(msg), client_fd, clients);
+        return;
+    }
+
+    for (int fd : room.members) {
         if (fd != client_fd && clients.count(fd)) {
-            clients[fd]->enqueueMessage(full_msg);
+            Client& recipient = *clients[fd];
+            recipient.enqueueMessage(msg->to(recipient, recipient.multi_room));
+        }
+    }
+}
+
+// Called with the clients mutex held: only posts one chunk per partition,
+// the per-recipient work happens on the pool
+void RoomManager::parallelBroadcast(Room& room, std::shared_ptr<const Outgoing> msg,
+    int client_fd, std::unordered_map<int, std::shared_ptr<Client>>& clients) {
+    if (!room.snapshot) {
+        auto snapshot = std::make_shared<MemberSnapshot>();
+        snapshot->partitions.resize(fanout_partitions);
+        for (int fd : room.members) {
+            auto it = clients.find(fd);
+            if (it != clients.end())
+                snapshot->partitions[partitionOf(fd)].push_back(it->second);
         }
+        room.snapshot = std::move(snapshot);
+    }
+    if (room.strands.size() != fanout_partitions) {
+        room.strands.clear();
+        for (std::size_t i = 0; i < fanout_partitions; ++i)
+            room.strands.push_back(std::make_shared<Strand>(*fanout_pool));
+    }
+
+    for (std::size_t i = 0; i < fanout_partitions; ++i) {
+        if (room.snapshot->partitions[i].empty()) continue;
+
+        room.in_flight->fetch_add(1);
+        room.strands[i]->post([snapshot = room.snapshot, in_flight = room.in_flight, msg, i, client_fd] {
+            for (const auto& recipient : snapshot->partitions[i]) {
+                if (recipient->socket_fd != client_fd)
+                    recipient->enqueueMessage(msg->to(*recipient, recipient->multi_room));
+            }
+            in_flight->fetch_sub(1);
+        });
     }
 }
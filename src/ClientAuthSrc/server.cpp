@@ -7,7 +7,33 @@
 
 #include "../../include/ClientAuthInc/server.hpp"
 
-Server::Server(int port) : port(port), server_fd(INVALID_SOCKET) {}
+#include <cstring>
+
+namespace {
+    // Resets a refused connection straight away: no thread, no TIME_WAIT
+    void rejectConnection(SOCKET fd, const char* reason) {
+        send(fd, reason, static_cast<int>(strlen(reason)), 0);
+        linger hard_close{ 1, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_LINGER, (const char*)&hard_close, sizeof(hard_close));
+        closesocket(fd);
+    }
+
+    // Accepted sockets inherit the listener's non-blocking mode; the handler
+    // threads use blocking recv, so switch it back and keep the handle out
+    // of any child processes
+    void prepareClientSocket(SOCKET fd) {
+        u_long blocking = 0;
+        ioctlsocket(fd, FIONBIO, &blocking);
+        SetHandleInformation(reinterpret_cast<HANDLE>(fd), HANDLE_FLAG_INHERIT, 0);
+        OutputCoalescer::tuneSocket(fd);
+    }
+}
+
+Server::Server(int port, const ServerConfig& config)
+    : port(port), server_fd(INVALID_SOCKET), config(config),
+      limiter(config.max_connections, config.per_ip_connect_rate, config.per_ip_connect_burst,
+          config.ip_table_size),
+      placement(config.network_cores) {}
 
 // Function to set up the server socket
 void Server::setupServerSocket() {
@@ -32,6 +58,9 @@ void Server::setupServerSocket() {
     int opt = 1;
 	// Set socket options to allow address reuse
     setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
+	// Low-latency mode tuning has to happen before bind/listen
+    BusyPoll::configure(config);
+    BusyPoll::tuneListener(server_fd);
 
 	// Bind the socket to the address and port
     if (bind(server_fd, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR) {
@@ -47,21 +76,86 @@ void Server::setupServerSocket() {
 
 // Function to accept incoming connections and handle them in separate threads
 void Server::acceptConnections() {
+    // Non-blocking listener: each wakeup drains the backlog in one batch
+    u_long non_blocking = 1;
+    ioctlsocket(server_fd, FIONBIO, &non_blocking);
+    SetHandleInformation(reinterpret_cast<HANDLE>(server_fd), HANDLE_FLAG_INHERIT, 0);
+    if (!config.network_cores.empty())
+        ThreadPlacement::pinCurrentThread(config.network_cores.front());
+
     while (true) {
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(server_fd, &readSet);
+        if (select(0, &readSet, nullptr, nullptr, nullptr) <= 0) continue;
+
+        // Saturated: leave new connections in the listen backlog until the
+        // overload controller has seen things calm down
+        if (OverloadController::acceptsPaused()) {
+            std::this_thread::sleep_for(OverloadController::probeInterval());
+            continue;
+        }
+        acceptBatch();
+    }
+}
+
+// Function to accept everything pending on the listener, up to one batch
+void Server::acceptBatch() {
+    int rejected = 0;
+    for (int i = 0; i < config.accept_batch; ++i) {
         sockaddr_in client_addr{};
         int len = sizeof(client_addr);
         SOCKET client_fd = accept(server_fd, (sockaddr*)&client_addr, &len);
-        if (client_fd == INVALID_SOCKET) continue;
+        if (client_fd == INVALID_SOCKET) {
+            // WSAEWOULDBLOCK means the backlog is empty; anything else
+            // (e.g. out of descriptors) gets a short back-off
+            if (WSAGetLastError() != WSAEWOULDBLOCK)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            break;
+        }
+
+        // Admission runs before any thread exists for the connection
+        ConnectionLimiter::Verdict verdict = limiter.admit(client_addr.sin_addr.s_addr);
+        if (verdict != ConnectionLimiter::Verdict::Admit) {
+            rejectConnection(client_fd, verdict == ConnectionLimiter::Verdict::RejectFull
+                ? "Server full, try again later\n" : "Too many connections, slow down\n");
+            ++rejected;
+            continue;
+        }
 
-        // Use a lambda to wrap the function call for std::thread
-        std::thread([client_fd]() {
-            ClientHandler::handleClient(client_fd);
-        }).detach();
+        prepareClientSocket(client_fd);
+        int core = placement.steer(client_fd);
+        try {
+            // Use a lambda to wrap the function call for std::thread
+            std::thread([this, client_fd, core]() {
+                ThreadPlacement::pinCurrentThread(core);
+                ClientHandler::handleClient(static_cast<int>(client_fd));
+                limiter.release();
+            }).detach();
+        }
+        catch (const std::system_error& e) {
+            std::cerr << "Thread creation failed: " << e.what() << std::endl;
+            limiter.release();
+            closesocket(client_fd);
+        }
+    }
+
+    if (rejected > 0) {
+        std::cout << "Rejected " << rejected << " connection(s) (active: " << limiter.activeConnections()
+            << ", total full: " << limiter.rejectedFull() << ", total rate-limited: " << limiter.rejectedRate()
+            << ")" << std::endl;
     }
 }
 
 // Function to start the server
 void Server::start() {
     setupServerSocket();
+    ClientHandler::configure(config);
+    ClientHandler::addStatsSource("placement", [this] { return placement.report(); });
+    ClientHandler::addStatsSource("coalescer", OutputCoalescer::report);
+    if (!config.local_socket_path.empty()) {
+        local = std::make_unique<LocalTransport>(config);
+        if (local->start()) ClientHandler::addStatsSource("local", [this] { return local->report(); });
+    }
     acceptConnections();
 }
@@ -0,0 +1,180 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : server_config.cpp
+ * Description : Reads ServerConfig settings from the command line or a
+                 config file
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/server_config.hpp"
+
+#include <concepts>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+    std::string trimmed(const std::string& text) {
+        std::size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return "";
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    // One parser per field type; each rejects trailing junk
+    template <typename T>
+    bool parseNumber(const std::string& text, T& out) {
+        std::istringstream in(text);
+        T value{};
+        if (!(in >> value) || !(in >> std::ws).eof()) return false;
+        out = value;
+        return true;
+    }
+
+    bool parse(const std::string& text, bool& out) {
+        if (text == "true" || text == "on" || text == "1") out = true;
+        else if (text == "false" || text == "off" || text == "0") out = false;
+        else return false;
+        return true;
+    }
+    bool parse(const std::string& text, int& out) { return parseNumber(text, out); }
+    // Streams would wrap "-1" around instead of failing
+    template <std::unsigned_integral T>
+    bool parse(const std::string& text, T& out) {
+        return text.find('-') == std::string::npos && parseNumber(text, out);
+    }
+    bool parse(const std::string& text, double& out) { return parseNumber(text, out); }
+    bool parse(const std::string& text, std::string& out) {
+        out = text;
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool parse(const std::string& text, std::chrono::duration<Rep, Period>& out) {
+        long long count = 0;
+        if (!parseNumber(text, count) || count < 0) return false;
+        out = std::chrono::duration<Rep, Period>(static_cast<Rep>(count));
+        return true;
+    }
+
+    template <typename T>
+    bool parse(const std::string& text, std::vector<T>& out) {
+        std::vector<T> values;
+        std::istringstream items(text);
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            item = trimmed(item);
+            if (item.empty()) continue;
+            T value{};
+            if (!parse(item, value)) return false;
+            values.push_back(std::move(value));
+        }
+        out = std::move(values);
+        return true;
+    }
+
+    using Setter = std::function<bool(ServerConfig&, const std::string&)>;
+
+    template <typename T>
+    Setter field(T ServerConfig::* member) {
+        return [member](ServerConfig& config, const std::string& value) { return parse(value, config.*member); };
+    }
+
+    const std::unordered_map<std::string, Setter>& setters() {
+        static const std::unordered_map<std::string, Setter> table = {
+            { "timer_tick", field(&ServerConfig::timer_tick) },
+            { "auth_timeout", field(&ServerConfig::auth_timeout) },
+            { "idle_timeout", field(&ServerConfig::idle_timeout) },
+            { "heartbeat_enabled", field(&ServerConfig::heartbeat_enabled) },
+            { "heartbeat_interval", field(&ServerConfig::heartbeat_interval) },
+            { "heartbeat_timeout", field(&ServerConfig::heartbeat_timeout) },
+            { "accept_batch", field(&ServerConfig::accept_batch) },
+            { "max_connections", field(&ServerConfig::max_connections) },
+            { "per_ip_connect_rate", field(&ServerConfig::per_ip_connect_rate) },
+            { "per_ip_connect_burst", field(&ServerConfig::per_ip_connect_burst) },
+            { "ip_table_size", field(&ServerConfig::ip_table_size) },
+            { "fanout_threshold", field(&ServerConfig::fanout_threshold) },
+            { "fanout_partitions", field(&ServerConfig::fanout_partitions) },
+            { "fanout_workers", field(&ServerConfig::fanout_workers) },
+            { "network_cores", field(&ServerConfig::network_cores) },
+            { "worker_cores", field(&ServerConfig::worker_cores) },
+            { "busy_poll", field(&ServerConfig::busy_poll) },
+            { "busy_poll_budget", field(&ServerConfig::busy_poll_budget) },
+            { "busy_poll_max_spinners", field(&ServerConfig::busy_poll_max_spinners) },
+            { "coalesce_output", field(&ServerConfig::coalesce_output) },
+            { "coalesce_window", field(&ServerConfig::coalesce_window) },
+            { "coalesce_bytes", field(&ServerConfig::coalesce_bytes) },
+            { "max_rooms_per_client", field(&ServerConfig::max_rooms_per_client) },
+            { "monitor_users", field(&ServerConfig::monitor_users) },
+            { "rooms_page_size", field(&ServerConfig::rooms_page_size) },
+            { "rooms_refresh", field(&ServerConfig::rooms_refresh) },
+            { "overload_control", field(&ServerConfig::overload_control) },
+            { "overload_probe_interval", field(&ServerConfig::overload_probe_interval) },
+            { "overload_lag_threshold", field(&ServerConfig::overload_lag_threshold) },
+            { "overload_sojourn_threshold", field(&ServerConfig::overload_sojourn_threshold) },
+            { "overload_monitor_sample", field(&ServerConfig::overload_monitor_sample) },
+            { "flood_client_msgs_per_sec", field(&ServerConfig::flood_client_msgs_per_sec) },
+            { "flood_client_msg_burst", field(&ServerConfig::flood_client_msg_burst) },
+            { "flood_client_bytes_per_sec", field(&ServerConfig::flood_client_bytes_per_sec) },
+            { "flood_client_byte_burst", field(&ServerConfig::flood_client_byte_burst) },
+            { "flood_room_msgs_per_sec", field(&ServerConfig::flood_room_msgs_per_sec) },
+            { "flood_room_msg_burst", field(&ServerConfig::flood_room_msg_burst) },
+            { "flood_room_bytes_per_sec", field(&ServerConfig::flood_room_bytes_per_sec) },
+            { "flood_room_byte_burst", field(&ServerConfig::flood_room_byte_burst) },
+            { "flood_max_delay", field(&ServerConfig::flood_max_delay) },
+            { "flood_disconnect_strikes", field(&ServerConfig::flood_disconnect_strikes) },
+            { "flood_strike_window", field(&ServerConfig::flood_strike_window) },
+            { "flood_exempt_local", field(&ServerConfig::flood_exempt_local) },
+            { "filter_wordlist", field(&ServerConfig::filter_wordlist) },
+            { "history_retention", field(&ServerConfig::history_retention) },
+            { "history_max_messages", field(&ServerConfig::history_max_messages) },
+            { "search_page_size", field(&ServerConfig::search_page_size) },
+            { "search_max_results", field(&ServerConfig::search_max_results) },
+            { "resume_grace", field(&ServerConfig::resume_grace) },
+            { "resume_backlog", field(&ServerConfig::resume_backlog) },
+            { "credential_file", field(&ServerConfig::credential_file) },
+            { "auth_workers", field(&ServerConfig::auth_workers) },
+            { "auth_queue_limit", field(&ServerConfig::auth_queue_limit) },
+            { "auth_cache_ttl", field(&ServerConfig::auth_cache_ttl) },
+            { "auth_max_failures", field(&ServerConfig::auth_max_failures) },
+            { "auth_lockout", field(&ServerConfig::auth_lockout) },
+            { "local_socket_path", field(&ServerConfig::local_socket_path) },
+            { "local_ring_bytes", field(&ServerConfig::local_ring_bytes) },
+            { "capture_file", field(&ServerConfig::capture_file) },
+            { "compression", field(&ServerConfig::compression) },
+            { "compression_level", field(&ServerConfig::compression_level) },
+            { "compression_window_bits", field(&ServerConfig::compression_window_bits) },
+            { "compression_mem_level", field(&ServerConfig::compression_mem_level) },
+            { "compression_shared_min", field(&ServerConfig::compression_shared_min) },
+            { "compression_rooms", field(&ServerConfig::compression_rooms) },
+            { "reload_interval", field(&ServerConfig::reload_interval) },
+        };
+        return table;
+    }
+}
+
+bool ServerConfig::set(const std::string& name, const std::string& value) {
+    auto it = setters().find(name);
+    return it != setters().end() && it->second(*this, trimmed(value));
+}
+
+bool ServerConfig::load(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::string line;
+    int number = 0;
+    while (std::getline(file, line)) {
+        ++number;
+        line = trimmed(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos || !set(trimmed(line.substr(0, equals)), line.substr(equals + 1))) {
+            error = path + ":" + std::to_string(number) + ": bad setting '" + line + "'";
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : session_store.cpp
+ * Description : Resume tokens and the sessions parked under them while a
+                 client is disconnected
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/session_store.hpp"
+
+#include <random>
+#include <sstream>
+
+std::string SessionStore::newToken() {
+    // random_device is backed by the OS CSPRNG on the platforms we build for
+    thread_local std::random_device source;
+    static const char HEX[] = "0123456789abcdef";
+    std::string token;
+    for (int i = 0; i < 4; ++i) {
+        std::uint32_t word = source();
+        for (int nibble = 0; nibble < 8; ++nibble) {
+            token += HEX[word & 0xF];
+            word >>= 4;
+        }
+    }
+    return token;
+}
+
+void SessionStore::park(const std::string& token, Session session) {
+    std::lock_guard<std::mutex> lock(mutex);
+    sessions[token] = std::move(session);
+    parked.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool SessionStore::setExpiry(const std::string& token, TimingWheel::TimerId expiry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sessions.find(token);
+    if (it == sessions.end()) return false;
+    it->second.expiry = expiry;
+    return true;
+}
+
+std::optional<SessionStore::Session> SessionStore::take(const std::string& token) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sessions.find(token);
+    if (it == sessions.end()) return std::nullopt;
+
+    Session session = std::move(it->second);
+    sessions.erase(it);
+    return session;
+}
+
+std::optional<SessionStore::Session> SessionStore::resume(const std::string& token) {
+    auto session = take(token);
+    if (session) resumed.fetch_add(1, std::memory_order_relaxed);
+    return session;
+}
+
+std::optional<SessionStore::Session> SessionStore::expire(const std::string& token) {
+    return take(token);
+}
+
+std::string SessionStore::report() const {
+    std::size_t waiting;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        waiting = sessions.size();
+    }
+    std::ostringstream out;
+    out << "Sessions: " << waiting << " parked for resume, "
+        << parked.load(std::memory_order_relaxed) << " parked in total, "
+        << resumed.load(std::memory_order_relaxed) << " resumed\n";
+    return out.str();
+}
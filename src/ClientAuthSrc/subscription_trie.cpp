@@ -0,0 +1,111 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : subscription_trie.cpp
+ * Description : Room-name patterns for monitoring clients, indexed by
+                 dot-separated segment
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/subscription_trie.hpp"
+
+#include <algorithm>
+
+namespace {
+    bool eraseValue(std::vector<int>& values, int value) {
+        auto it = std::find(values.begin(), values.end(), value);
+        if (it == values.end()) return false;
+        *it = values.back();
+        values.pop_back();
+        return true;
+    }
+}
+
+std::vector<std::string_view> SubscriptionTrie::split(std::string_view name) {
+    std::vector<std::string_view> segments;
+    std::size_t start = 0;
+    while (true) {
+        std::size_t dot = name.find('.', start);
+        segments.push_back(name.substr(start, dot == std::string_view::npos ? std::string_view::npos : dot - start));
+        if (dot == std::string_view::npos) break;
+        start = dot + 1;
+    }
+    return segments;
+}
+
+bool SubscriptionTrie::validPattern(std::string_view pattern) {
+    if (pattern.empty() || pattern.find_first_of(" \t") != std::string_view::npos) return false;
+    for (std::string_view segment : split(pattern)) {
+        if (segment.empty()) return false;
+        if (segment.find('*') != std::string_view::npos && segment != "*") return false;
+    }
+    return true;
+}
+
+bool SubscriptionTrie::add(std::string_view pattern, int subscriber) {
+    std::vector<std::string_view> segments = split(pattern);
+    bool trailing_star = segments.back() == "*";
+    if (trailing_star) segments.pop_back();
+
+    Node* node = &root;
+    for (std::string_view segment : segments) {
+        std::unique_ptr<Node>& next = segment == "*"
+            ? node->star : node->children[std::string(segment)];
+        if (!next) next = std::make_unique<Node>();
+        node = next.get();
+    }
+
+    std::vector<int>& list = trailing_star ? node->rest : node->exact;
+    if (std::find(list.begin(), list.end(), subscriber) != list.end()) return false;
+    list.push_back(subscriber);
+    ++count;
+    return true;
+}
+
+bool SubscriptionTrie::remove(std::string_view pattern, int subscriber) {
+    bool removed = false;
+    removeFrom(root, split(pattern), 0, subscriber, removed);
+    if (removed) --count;
+    return removed;
+}
+
+// Returns true if `node` ended up empty, so the caller can prune it
+bool SubscriptionTrie::removeFrom(Node& node, const std::vector<std::string_view>& segments, std::size_t index,
+    int subscriber, bool& removed) {
+    if (index == segments.size()) {
+        removed = eraseValue(node.exact, subscriber);
+    }
+    else if (index + 1 == segments.size() && segments[index] == "*") {
+        removed = eraseValue(node.rest, subscriber);
+    }
+    else if (segments[index] == "*") {
+        if (node.star && removeFrom(*node.star, segments, index + 1, subscriber, removed)) node.star.reset();
+    }
+    else {
+        auto it = node.children.find(segments[index]);
+        if (it != node.children.end() && removeFrom(*it->second, segments, index + 1, subscriber, removed))
+            node.children.erase(it);
+    }
+    return node.empty();
+}
+
+void SubscriptionTrie::collect(const Node& node, const std::vector<std::string_view>& segments, std::size_t index,
+    std::vector<int>& out) {
+    if (index == segments.size()) {
+        out.insert(out.end(), node.exact.begin(), node.exact.end());
+        return;
+    }
+    out.insert(out.end(), node.rest.begin(), node.rest.end());
+
+    auto it = node.children.find(segments[index]);
+    if (it != node.children.end()) collect(*it->second, segments, index + 1, out);
+    if (node.star) collect(*node.star, segments, index + 1, out);
+}
+
+void SubscriptionTrie::match(std::string_view room, std::vector<int>& out) const {
+    if (count == 0) return;
+    std::size_t first = out.size();
+    collect(root, split(room), 0, out);
+    // Several patterns of one subscriber may match the same room
+    std::sort(out.begin() + first, out.end());
+    out.erase(std::unique(out.begin() + first, out.end()), out.end());
+}
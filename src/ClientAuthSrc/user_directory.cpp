@@ -0,0 +1,39 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : user_directory.cpp
+ * Description : Concurrent username -> client index used for uniqueness
+                 checks and direct messages
+ ****************************************************/
+
+#include "../../include/ClientAuthInc/user_directory.hpp"
+
+#include <functional>
+
+std::array<UserDirectory::Shard, UserDirectory::SHARD_COUNT> UserDirectory::shards;
+
+UserDirectory::Shard& UserDirectory::shardFor(const std::string& username) {
+    return shards[std::hash<std::string>{}(username) % SHARD_COUNT];
+}
+
+bool UserDirectory::claim(const std::string& username, std::shared_ptr<Client> client) {
+    Shard& shard = shardFor(username);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.users.emplace(username, std::move(client)).second;
+}
+
+void UserDirectory::release(const std::string& username, const Client* client) {
+    Shard& shard = shardFor(username);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.users.find(username);
+    if (it != shard.users.end() && it->second.get() == client) {
+        shard.users.erase(it);
+    }
+}
+
+std::shared_ptr<Client> UserDirectory::find(const std::string& username) {
+    Shard& shard = shardFor(username);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.users.find(username);
+    return it != shard.users.end() ? it->second : nullptr;
+}
@@ -0,0 +1,368 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : ContentFilter.cpp
+ * Description : Inline moderation stage: vectorised line sanitisation and
+                 an Aho-Corasick blocklist that can mask, reject or flag
+ ****************************************************/
+
+#include "../include/ContentFilter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CONTENT_FILTER_SSE2 1
+#endif
+
+namespace {
+    const char REPLACEMENT_CHAR[] = "\xEF\xBF\xBD"; // U+FFFD
+
+    // Returns the offset of the first byte at or after `pos` that is not
+    // printable ASCII (0x20-0x7E), or `size` if there is none
+    std::size_t skipPlain(const char* data, std::size_t size, std::size_t pos) {
+#ifdef CONTENT_FILTER_SSE2
+        const __m128i space = _mm_set1_epi8(0x20);
+        const __m128i del = _mm_set1_epi8(0x7F);
+        while (pos + 16 <= size) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            // Signed compare: bytes >= 0x80 are negative, so one test
+            // catches both control characters and the start of UTF-8
+            __m128i special = _mm_or_si128(_mm_cmplt_epi8(chunk, space), _mm_cmpeq_epi8(chunk, del));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+            if (mask != 0) return pos + std::countr_zero(mask);
+            pos += 16;
+        }
+#endif
+        while (pos < size) {
+            unsigned char c = static_cast<unsigned char>(data[pos]);
+            if (c < 0x20 || c >= 0x7F) break;
+            ++pos;
+        }
+        return pos;
+    }
+
+    bool isContinuation(unsigned char c) {
+        return (c & 0xC0) == 0x80;
+    }
+
+    // Length of the well-formed UTF-8 sequence at `data`, or 0 if malformed
+    // (overlong forms, surrogates and code points above U+10FFFF included)
+    std::size_t utf8Length(const unsigned char* data, std::size_t available) {
+        unsigned char lead = data[0];
+        std::size_t length;
+        unsigned char low = 0x80, high = 0xBF; // allowed range of the second byte
+
+        if (lead >= 0xC2 && lead <= 0xDF) length = 2;
+        else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            if (lead == 0xE0) low = 0xA0;
+            if (lead == 0xED) high = 0x9F;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            if (lead == 0xF0) low = 0x90;
+            if (lead == 0xF4) high = 0x8F;
+        }
+        else return 0;
+
+        if (available < length || data[1] < low || data[1] > high) return 0;
+        for (std::size_t i = 2; i < length; ++i) {
+            if (!isContinuation(data[i])) return 0;
+        }
+        return length;
+    }
+
+    // Backspace removes a whole code point, not just its last byte
+    void eraseLastCodePoint(std::string& out) {
+        while (!out.empty() && isContinuation(static_cast<unsigned char>(out.back()))) out.pop_back();
+        if (!out.empty()) out.pop_back();
+    }
+
+    ContentFilter::Action parseAction(const std::string& name) {
+        if (name == "reject") return ContentFilter::Action::Reject;
+        if (name == "flag") return ContentFilter::Action::Flag;
+        return ContentFilter::Action::Mask;
+    }
+}
+
+std::string ContentFilter::sanitize(std::string_view input) {
+    const char* data = input.data();
+    std::size_t size = input.size();
+    std::string out;
+    out.reserve(size);
+
+    std::size_t pos = 0;
+    while (pos < size) {
+        std::size_t end = skipPlain(data, size, pos);
+        out.append(data + pos, end - pos);
+        pos = end;
+        if (pos == size) break;
+
+        unsigned char c = static_cast<unsigned char>(data[pos]);
+        if (c < 0x80) {
+            if (c == '\t') out += '\t';
+            else if (c == 0x08 || c == 0x7F) eraseLastCodePoint(out);
+            ++pos; // every other control character is dropped
+            continue;
+        }
+
+        std::size_t length = utf8Length(reinterpret_cast<const unsigned char*>(data + pos), size - pos);
+        if (length == 0) {
+            out += REPLACEMENT_CHAR;
+            ++pos;
+        }
+        else {
+            out.append(data + pos, length);
+            pos += length;
+        }
+    }
+    return out;
+}
+
+bool ContentFilter::load(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(reload_mutex);
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Content filter: cannot open " << path.string() << std::endl;
+        return false;
+    }
+
+    std::vector<std::pair<std::string, Action>> patterns;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream iss(line);
+        std::string word, action;
+        if (!(iss >> word)) continue;
+        iss >> action;
+        if (word.size() > 0xFFFF) continue;
+        std::transform(word.begin(), word.end(), word.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        patterns.emplace_back(std::move(word), parseAction(action));
+    }
+
+    automaton.store(compile(patterns));
+    source = path;
+    std::error_code ec;
+    loaded_at = std::filesystem::last_write_time(path, ec);
+    std::cout << "Content filter: loaded " << patterns.size() << " patterns from " << path.string() << std::endl;
+    return true;
+}
+
+bool ContentFilter::reloadIfChanged() {
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(reload_mutex);
+        if (source.empty()) return false;
+        std::error_code ec;
+        auto modified = std::filesystem::last_write_time(source, ec);
+        if (ec || modified == loaded_at) return false;
+        path = source;
+    }
+    return load(path);
+}
+
+bool ContentFilter::enabled() const {
+    return automaton.load() != nullptr;
+}
+
+// Classic Aho-Corasick construction, with failure transitions folded into a
+// dense table so that scanning is one lookup per input byte
+std::shared_ptr<const ContentFilter::Automaton> ContentFilter::compile(
+    const std::vector<std::pair<std::string, Action>>& patterns) {
+    auto dfa = std::make_shared<Automaton>();
+
+    // Byte classes; upper-case letters share the lower-case column
+    for (const auto& pattern : patterns) {
+        for (unsigned char c : pattern.first) {
+            if (dfa->byte_class[c] == 0 && dfa->class_count < 256)
+                dfa->byte_class[c] = static_cast<std::uint8_t>(dfa->class_count++);
+        }
+    }
+    for (int c = 'a'; c <= 'z'; ++c) dfa->byte_class[std::toupper(c)] = dfa->byte_class[c];
+    const std::uint32_t classes = dfa->class_count;
+    const std::uint32_t NONE = 0xFFFFFFFFu;
+
+    // Trie
+    std::vector<std::uint32_t> trie(classes, NONE);
+    dfa->mask_length.assign(1, 0);
+    dfa->actions.assign(1, 0);
+    for (const auto& [word, action] : patterns) {
+        std::uint32_t state = 0;
+        for (unsigned char c : word) {
+            std::uint32_t cls = dfa->byte_class[c];
+            if (trie[state * classes + cls] == NONE) {
+                trie[state * classes + cls] = static_cast<std::uint32_t>(dfa->actions.size());
+                trie.resize(trie.size() + classes, NONE);
+                dfa->mask_length.push_back(0);
+                dfa->actions.push_back(0);
+            }
+            state = trie[state * classes + cls];
+        }
+        dfa->max_length = (std::max)(dfa->max_length, word.size());
+        dfa->actions[state] |= static_cast<std::uint8_t>(1u << static_cast<int>(action));
+        if (action == Action::Mask)
+            dfa->mask_length[state] = static_cast<std::uint16_t>(word.size());
+    }
+
+    // Breadth-first: resolve failure links and fill in missing transitions
+    std::size_t states = dfa->actions.size();
+    std::vector<std::uint32_t> goto_state(states * classes, 0);
+    std::vector<std::uint32_t> fail(states, 0);
+    std::queue<std::uint32_t> frontier;
+
+    for (std::uint32_t c = 0; c < classes; ++c) {
+        if (trie[c] == NONE) continue;
+        goto_state[c] = trie[c];
+        frontier.push(trie[c]);
+    }
+    while (!frontier.empty()) {
+        std::uint32_t state = frontier.front();
+        frontier.pop();
+        for (std::uint32_t c = 0; c < classes; ++c) {
+            std::uint32_t child = trie[state * classes + c];
+            std::uint32_t fallback = goto_state[fail[state] * classes + c];
+            if (child == NONE) {
+                goto_state[state * classes + c] = fallback;
+                continue;
+            }
+            goto_state[state * classes + c] = child;
+            fail[child] = fallback;
+            // Inherit every pattern that ends here as a suffix of this one
+            dfa->actions[child] |= dfa->actions[fallback];
+            dfa->mask_length[child] = (std::max)(dfa->mask_length[child], dfa->mask_length[fallback]);
+            frontier.push(child);
+        }
+    }
+
+    // Final table: tagged row offsets
+    dfa->next.resize(goto_state.size());
+    for (std::size_t i = 0; i < goto_state.size(); ++i) {
+        std::uint32_t target = goto_state[i];
+        dfa->next[i] = target * classes | (dfa->actions[target] ? Automaton::MATCH_BIT : 0);
+    }
+    return dfa;
+}
+
+ContentFilter::Result ContentFilter::apply(std::string_view line) {
+    Result result;
+    std::shared_ptr<const Automaton> dfa = automaton.load();
+    lines_scanned.fetch_add(1, std::memory_order_relaxed);
+    bytes_scanned.fetch_add(line.size(), std::memory_order_relaxed);
+    if (!dfa) {
+        result.text.assign(line);
+        return result;
+    }
+
+    const std::uint32_t* next = dfa->next.data();
+    const std::uint8_t* byte_class = dfa->byte_class;
+    const std::uint32_t classes = dfa->class_count;
+    const std::uint8_t REJECT_BIT = 1u << static_cast<int>(Action::Reject);
+    const std::uint8_t FLAG_BIT = 1u << static_cast<int>(Action::Flag);
+    bool masked = false;
+
+    // Handles a match ending at offset `end`; returns false on reject
+    auto onMatch = [&](std::uint32_t row, std::size_t end) {
+        std::uint32_t state = (row & ~Automaton::MATCH_BIT) / classes;
+        std::uint8_t actions = dfa->actions[state];
+        if (actions & REJECT_BIT) return false;
+        if (actions & FLAG_BIT) result.flagged = true;
+
+        std::size_t length = dfa->mask_length[state];
+        if (length > 0) {
+            // Copy on first mask only; clean lines are copied exactly once
+            if (!masked) {
+                result.text.assign(line);
+                masked = true;
+            }
+            std::fill(result.text.begin() + (end + 1 - length), result.text.begin() + end + 1, '*');
+        }
+        return true;
+    };
+
+    const std::uint32_t M = Automaton::MATCH_BIT;
+    const unsigned char* text = reinterpret_cast<const unsigned char*>(line.data());
+
+    // Plain scan of [from, to) continuing from `row`
+    auto scan = [&](std::uint32_t row, std::size_t from, std::size_t to) {
+        for (std::size_t i = from; i < to; ++i) {
+            row = next[(row & ~M) + byte_class[text[i]]];
+            if ((row & M) && !onMatch(row, i)) return false;
+        }
+        return true;
+    };
+
+    // Each step of the scan waits on the previous table load. Long lines are
+    // therefore cut into four slices scanned in lockstep, each starting
+    // max_length - 1 bytes early so no match across a cut is lost.
+    bool rejected = false;
+    std::size_t size = line.size();
+    std::size_t overlap = dfa->max_length > 0 ? dfa->max_length - 1 : 0;
+    if (size >= 256 && dfa->max_length * 4 < size) {
+        std::size_t slice = size / 4;
+        std::size_t start[4] = { 0, slice - overlap, 2 * slice - overlap, 3 * slice - overlap };
+        std::size_t stop[4] = { slice, 2 * slice, 3 * slice, size };
+        std::uint32_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+
+        std::size_t common = slice; // the first lane is the shortest
+        std::size_t n = 0;
+        for (; n < common; ++n) {
+            r0 = next[(r0 & ~M) + byte_class[text[start[0] + n]]];
+            r1 = next[(r1 & ~M) + byte_class[text[start[1] + n]]];
+            r2 = next[(r2 & ~M) + byte_class[text[start[2] + n]]];
+            r3 = next[(r3 & ~M) + byte_class[text[start[3] + n]]];
+            if (!((r0 | r1 | r2 | r3) & M)) continue;
+
+            if (((r0 & M) && !onMatch(r0, start[0] + n))
+                || ((r1 & M) && !onMatch(r1, start[1] + n))
+                || ((r2 & M) && !onMatch(r2, start[2] + n))
+                || ((r3 & M) && !onMatch(r3, start[3] + n))) {
+                rejected = true;
+                break;
+            }
+        }
+        std::uint32_t rows[4] = { r0, r1, r2, r3 };
+        for (int k = 1; k < 4 && !rejected; ++k)
+            rejected = !scan(rows[k], start[k] + n, stop[k]);
+    }
+    else {
+        rejected = !scan(0, 0, size);
+    }
+
+    if (rejected) {
+        lines_rejected.fetch_add(1, std::memory_order_relaxed);
+        result.action = Action::Reject;
+        result.flagged = false;
+        result.text.clear();
+        return result;
+    }
+
+    if (masked) {
+        result.action = Action::Mask;
+        lines_masked.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        result.text.assign(line);
+    }
+    if (result.flagged) {
+        lines_flagged.fetch_add(1, std::memory_order_relaxed);
+        if (result.action == Action::None) result.action = Action::Flag;
+    }
+    return result;
+}
+
+std::string ContentFilter::report() const {
+    return "Content filter: " + std::string(enabled() ? "on" : "off") + ", "
+        + std::to_string(lines_scanned.load(std::memory_order_relaxed)) + " lines ("
+        + std::to_string(bytes_scanned.load(std::memory_order_relaxed)) + " bytes), "
+        + std::to_string(lines_masked.load(std::memory_order_relaxed)) + " masked, "
+        + std::to_string(lines_rejected.load(std::memory_order_relaxed)) + " rejected, "
+        + std::to_string(lines_flagged.load(std::memory_order_relaxed)) + " flagged\n";
+}
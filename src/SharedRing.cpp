@@ -0,0 +1,234 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : SharedRing.cpp
+ * Description : Single-producer/single-consumer message ring in named
+                 shared memory, with event wake-ups for parked consumers
+ ****************************************************/
+
+#include "../include/SharedRing.hpp"
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace {
+    std::size_t frameSize(std::size_t message) {
+        return 4 + ((message + 3) & ~std::size_t{ 3 });
+    }
+
+    std::uint32_t roundUpPowerOfTwo(std::uint32_t value) {
+        std::uint32_t result = 64;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    // A DACL granting this process's user, and no one else, full access.
+    // Free with LocalFree; null if the user cannot be determined.
+    PSECURITY_DESCRIPTOR ownerOnlyDescriptor() {
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &token)) return nullptr;
+        DWORD length = 0;
+        GetTokenInformation(token, TokenUser, nullptr, 0, &length);
+        std::vector<char> user(length);
+        LPSTR sid = nullptr;
+        bool found = length > 0 && GetTokenInformation(token, TokenUser, user.data(), length, &length)
+            && ConvertSidToStringSidA(reinterpret_cast<TOKEN_USER*>(user.data())->User.Sid, &sid);
+        CloseHandle(token);
+        if (!found) return nullptr;
+
+        std::string sddl = std::string("D:P(A;;GA;;;") + sid + ")";
+        LocalFree(sid);
+        PSECURITY_DESCRIPTOR descriptor = nullptr;
+        if (!ConvertStringSecurityDescriptorToSecurityDescriptorA(sddl.c_str(), SDDL_REVISION_1, &descriptor, nullptr))
+            return nullptr;
+        return descriptor;
+    }
+
+    // Announce that we are about to sleep, then look again: the other side
+    // stores its position before reading our flag, so either it sees the
+    // flag and signals, or we see its update here
+    template <typename Ready>
+    SharedRing::Wait park(std::atomic<std::uint32_t>& flag, HANDLE event, DWORD timeout_ms, HANDLE other,
+        Ready ready) {
+        flag.store(1, std::memory_order_seq_cst);
+        if (ready()) {
+            flag.store(0, std::memory_order_relaxed);
+            return SharedRing::Wait::Ready;
+        }
+        HANDLE handles[2] = { event, other };
+        DWORD result = WaitForMultipleObjects(other ? 2 : 1, handles, FALSE, timeout_ms);
+        flag.store(0, std::memory_order_relaxed);
+
+        if (result == WAIT_OBJECT_0) return SharedRing::Wait::Ready;
+        if (other && result == WAIT_OBJECT_0 + 1) return SharedRing::Wait::Other;
+        return SharedRing::Wait::Timeout;
+    }
+}
+
+// SharedRing
+
+bool SharedRing::empty() const {
+    return header->head.load(std::memory_order_relaxed) == header->tail.load(std::memory_order_acquire);
+}
+
+bool SharedRing::hasRoom(std::size_t message) const {
+    std::uint32_t capacity = size;
+    std::uint64_t tail = header->tail.load(std::memory_order_relaxed);
+    std::uint64_t head = header->head.load(std::memory_order_acquire);
+    std::size_t offset = static_cast<std::size_t>(tail & (capacity - 1));
+    std::size_t frame = frameSize(message);
+    std::size_t pad = capacity - offset < frame ? capacity - offset : 0;
+    return tail + pad + frame - head <= capacity;
+}
+
+bool SharedRing::push(std::string_view message) {
+    if (broken || message.size() > maxMessage() || !hasRoom(message.size())) return false;
+
+    std::uint32_t capacity = size;
+    std::uint64_t tail = header->tail.load(std::memory_order_relaxed);
+    // A misaligned tail can only come from the peer, and would put the
+    // wrap marker past the end of the buffer
+    if ((tail & 3) != 0) {
+        broken = true;
+        return false;
+    }
+    std::size_t offset = static_cast<std::size_t>(tail & (capacity - 1));
+    std::size_t frame = frameSize(message.size());
+    if (capacity - offset < frame) {
+        // Frames are 4-byte aligned, so there is always room for the marker
+        std::memcpy(data + offset, &WRAP, 4);
+        tail += capacity - offset;
+        offset = 0;
+    }
+
+    std::uint32_t length = static_cast<std::uint32_t>(message.size());
+    std::memcpy(data + offset, &length, 4);
+    std::memcpy(data + offset + 4, message.data(), message.size());
+    header->tail.store(tail + frame, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->consumer_parked.load(std::memory_order_relaxed)) SetEvent(data_event);
+    return true;
+}
+
+bool SharedRing::pop(std::string& out) {
+    if (broken || empty()) return false;
+
+    std::uint32_t capacity = size;
+    std::uint64_t head = header->head.load(std::memory_order_relaxed);
+    std::uint64_t tail = header->tail.load(std::memory_order_acquire);
+    // Our own producer never breaks any of these checks; a hostile or
+    // buggy peer can, and would otherwise have us read past the ring
+    auto reject = [this] {
+        broken = true;
+        return false;
+    };
+    if ((head & 3) != 0 || tail - head > capacity) return reject();
+
+    std::size_t offset = static_cast<std::size_t>(head & (capacity - 1));
+    std::uint32_t length;
+    std::memcpy(&length, data + offset, 4);
+    if (length == WRAP) {
+        // A wrap marker is always published together with the frame after it
+        head += capacity - offset;
+        offset = 0;
+        if (tail - head > capacity) return reject();
+        std::memcpy(&length, data, 4);
+    }
+    if (length > maxMessage() || offset + 4 + length > capacity || frameSize(length) > tail - head)
+        return reject();
+
+    out.assign(data + offset + 4, length);
+    header->head.store(head + frameSize(length), std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->producer_parked.load(std::memory_order_relaxed)) SetEvent(space_event);
+    return true;
+}
+
+SharedRing::Wait SharedRing::waitReadable(DWORD timeout_ms, HANDLE other) {
+    return park(header->consumer_parked, data_event, timeout_ms, other, [this] { return broken || !empty(); });
+}
+
+SharedRing::Wait SharedRing::waitWritable(std::size_t message, DWORD timeout_ms, HANDLE other) {
+    return park(header->producer_parked, space_event, timeout_ms, other,
+        [this, message] { return broken || hasRoom(message); });
+}
+
+// SharedRingPair
+
+SharedRingPair::~SharedRingPair() {
+    if (view) UnmapViewOfFile(view);
+    if (mapping) CloseHandle(mapping);
+    for (HANDLE event : events) {
+        if (event) CloseHandle(event);
+    }
+}
+
+std::unique_ptr<SharedRingPair> SharedRingPair::create(const std::string& name, std::uint32_t capacity) {
+    return map(name, capacity, true);
+}
+
+std::unique_ptr<SharedRingPair> SharedRingPair::open(const std::string& name, std::uint32_t capacity) {
+    return map(name, capacity, false);
+}
+
+std::unique_ptr<SharedRingPair> SharedRingPair::map(const std::string& name, std::uint32_t capacity, bool create) {
+    capacity = roundUpPowerOfTwo(capacity);
+    std::size_t ring_size = SharedRing::footprint(capacity);
+    std::size_t total = 2 * ring_size;
+    std::string base = "Local\\" + name;
+
+    std::unique_ptr<SharedRingPair> pair(new SharedRingPair());
+    pair->creator = create;
+
+    // Without it the objects would get the default DACL, which other
+    // processes in the session can open if they know the name
+    std::unique_ptr<void, HLOCAL(WINAPI*)(HLOCAL)> descriptor(create ? ownerOnlyDescriptor() : nullptr, LocalFree);
+    if (create && !descriptor) return nullptr;
+    SECURITY_ATTRIBUTES security{ sizeof(SECURITY_ATTRIBUTES), descriptor.get(), FALSE };
+    LPSECURITY_ATTRIBUTES attributes = create ? &security : nullptr;
+
+    if (create) {
+        pair->mapping = CreateFileMapping(INVALID_HANDLE_VALUE, attributes, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<std::uint64_t>(total) >> 32), static_cast<DWORD>(total), base.c_str());
+        // Never attach to a mapping someone else set up under our name
+        if (pair->mapping && GetLastError() == ERROR_ALREADY_EXISTS) return nullptr;
+    }
+    else {
+        pair->mapping = OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, base.c_str());
+    }
+    if (!pair->mapping) return nullptr;
+
+    pair->view = MapViewOfFile(pair->mapping, FILE_MAP_ALL_ACCESS, 0, 0, total);
+    if (!pair->view) return nullptr;
+
+    const char* suffixes[4] = { "-0d", "-0s", "-1d", "-1s" };
+    for (int i = 0; i < 4; ++i) {
+        std::string event_name = base + suffixes[i];
+        pair->events[i] = create
+            ? CreateEvent(attributes, FALSE, FALSE, event_name.c_str())
+            : OpenEvent(EVENT_MODIFY_STATE | SYNCHRONIZE, FALSE, event_name.c_str());
+        if (!pair->events[i]) return nullptr;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        char* base_address = static_cast<char*>(pair->view) + i * ring_size;
+        auto* header = reinterpret_cast<SharedRing::Header*>(base_address);
+        if (create) {
+            header = new (base_address) SharedRing::Header();
+            header->head.store(0);
+            header->tail.store(0);
+            header->consumer_parked.store(0);
+            header->producer_parked.store(0);
+            header->capacity = capacity;
+        }
+        else if (header->capacity != capacity) {
+            return nullptr;
+        }
+        pair->rings[i] = SharedRing(header, base_address + sizeof(SharedRing::Header), capacity,
+            pair->events[2 * i], pair->events[2 * i + 1]);
+    }
+    return pair;
+}
@@ -0,0 +1,212 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : ThreadPlacement.cpp
+ * Description : CPU pinning, RSS-aware connection steering and NUMA-local
+                 allocation for network and worker threads
+ ****************************************************/
+
+#include "../include/ThreadPlacement.hpp"
+
+#include <windows.h>
+#include <mstcpip.h>
+#include <array>
+#include <mutex>
+#include <new>
+#include <sstream>
+
+namespace {
+    thread_local int pinned_core = -1;
+
+    PROCESSOR_NUMBER toProcessorNumber(int core) {
+        PROCESSOR_NUMBER number{};
+        number.Group = static_cast<WORD>(core / 64);
+        number.Number = static_cast<BYTE>(core % 64);
+        return number;
+    }
+
+    // Arena state for one NUMA node
+    constexpr std::size_t MIN_CLASS_SHIFT = 4;    // 16 bytes
+    constexpr std::size_t MAX_CLASS_SHIFT = 12;   // 4 KiB
+    constexpr std::size_t CLASS_COUNT = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+    constexpr std::size_t CHUNK_SIZE = 1 << 20;
+    constexpr int MAX_NODES = 64;
+
+    struct FreeBlock { FreeBlock* next; };
+
+    struct NodeArena {
+        std::mutex mutex;
+        std::array<FreeBlock*, CLASS_COUNT> free_lists{};
+        char* bump = nullptr;
+        char* bump_end = nullptr;
+    };
+
+    std::array<NodeArena, MAX_NODES> arenas;
+
+    std::size_t sizeClass(std::size_t bytes) {
+        std::size_t shift = MIN_CLASS_SHIFT;
+        while ((std::size_t{ 1 } << shift) < bytes) ++shift;
+        return shift - MIN_CLASS_SHIFT;
+    }
+
+    void* commitOnNode(std::size_t bytes, int node) {
+        void* memory = VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes,
+            MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, static_cast<DWORD>(node));
+        if (!memory) {
+            // Node exhausted or not present: any memory beats failing the connection
+            memory = VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes,
+                MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, NUMA_NO_PREFERRED_NODE);
+        }
+        if (!memory) throw std::bad_alloc();
+        return memory;
+    }
+}
+
+// ThreadPlacement
+
+ThreadPlacement::ThreadPlacement(std::vector<int> cores) : cores(std::move(cores)) {
+    for (int core : this->cores) {
+        nodes.push_back(numaNodeOf(core));
+        stats.push_back(std::make_unique<CoreStats>());
+    }
+}
+
+int ThreadPlacement::steer(SOCKET socket) {
+    if (cores.empty()) return -1;
+
+    int rx_node = -1;
+    int rx_cpu = incomingCpu(socket, &rx_node);
+    std::size_t index = pick(rx_cpu, rx_node);
+
+    CoreStats& core_stats = *stats[index];
+    core_stats.connections.fetch_add(1, std::memory_order_relaxed);
+    if (rx_cpu == cores[index])
+        core_stats.rx_local.fetch_add(1, std::memory_order_relaxed);
+    else if (rx_node >= 0 && rx_node == nodes[index])
+        core_stats.node_local.fetch_add(1, std::memory_order_relaxed);
+    else
+        core_stats.remote.fetch_add(1, std::memory_order_relaxed);
+    return cores[index];
+}
+
+int ThreadPlacement::next() {
+    if (cores.empty()) return -1;
+    return cores[cursor.fetch_add(1, std::memory_order_relaxed) % cores.size()];
+}
+
+std::size_t ThreadPlacement::pick(int rx_cpu, int rx_node) {
+    if (rx_cpu >= 0) {
+        for (std::size_t i = 0; i < cores.size(); ++i) {
+            if (cores[i] == rx_cpu) return i;
+        }
+    }
+
+    // Spread across our cores on the RSS node, starting from the cursor
+    unsigned start = cursor.fetch_add(1, std::memory_order_relaxed);
+    if (rx_node >= 0) {
+        for (std::size_t offset = 0; offset < cores.size(); ++offset) {
+            std::size_t i = (start + offset) % cores.size();
+            if (nodes[i] == rx_node) return i;
+        }
+    }
+    return start % cores.size();
+}
+
+std::string ThreadPlacement::report() const {
+    std::ostringstream out;
+    out << "Thread placement (per core: connections, rx-core, same-node, remote):\n";
+    if (cores.empty()) {
+        out << "- not pinned\n";
+        return out.str();
+    }
+    for (std::size_t i = 0; i < cores.size(); ++i) {
+        const CoreStats& core_stats = *stats[i];
+        out << "- core " << cores[i] << " (node " << nodes[i] << "): "
+            << core_stats.connections.load(std::memory_order_relaxed) << ", "
+            << core_stats.rx_local.load(std::memory_order_relaxed) << ", "
+            << core_stats.node_local.load(std::memory_order_relaxed) << ", "
+            << core_stats.remote.load(std::memory_order_relaxed) << "\n";
+    }
+    return out.str();
+}
+
+bool ThreadPlacement::pinCurrentThread(int core) {
+    if (core < 0) return false;
+
+    GROUP_AFFINITY affinity{};
+    affinity.Group = static_cast<WORD>(core / 64);
+    affinity.Mask = KAFFINITY{ 1 } << (core % 64);
+    if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr)) return false;
+
+    pinned_core = core;
+    return true;
+}
+
+int ThreadPlacement::pinnedCore() {
+    return pinned_core;
+}
+
+int ThreadPlacement::numaNodeOf(int core) {
+    PROCESSOR_NUMBER number = toProcessorNumber(core);
+    USHORT node = 0;
+    return GetNumaProcessorNodeEx(&number, &node) ? node : 0;
+}
+
+int ThreadPlacement::currentNumaNode() {
+    PROCESSOR_NUMBER number{};
+    GetCurrentProcessorNumberEx(&number);
+    USHORT node = 0;
+    return GetNumaProcessorNodeEx(&number, &node) ? node : 0;
+}
+
+int ThreadPlacement::incomingCpu(SOCKET socket, int* numa_node) {
+    SOCKET_PROCESSOR_AFFINITY affinity{};
+    DWORD bytes = 0;
+    if (WSAIoctl(socket, SIO_QUERY_RSS_PROCESSOR_INFO, nullptr, 0, &affinity, sizeof(affinity),
+        &bytes, nullptr, nullptr) != 0) {
+        return -1;
+    }
+    if (numa_node) *numa_node = affinity.NumaNodeId;
+    return affinity.Processor.Group * 64 + affinity.Processor.Number;
+}
+
+// NumaArena
+
+void* NumaArena::allocate(std::size_t bytes, int node) {
+    if (node < 0 || node >= MAX_NODES) node = 0;
+    if (bytes > (std::size_t{ 1 } << MAX_CLASS_SHIFT)) return commitOnNode(bytes, node);
+
+    std::size_t cls = sizeClass(bytes);
+    std::size_t block = std::size_t{ 1 } << (cls + MIN_CLASS_SHIFT);
+    NodeArena& arena = arenas[node];
+
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    if (FreeBlock* head = arena.free_lists[cls]) {
+        arena.free_lists[cls] = head->next;
+        return head;
+    }
+    if (arena.bump == nullptr || static_cast<std::size_t>(arena.bump_end - arena.bump) < block) {
+        // The tail of the old chunk is abandoned; chunks are large enough
+        // that this costs well under one percent
+        arena.bump = static_cast<char*>(commitOnNode(CHUNK_SIZE, node));
+        arena.bump_end = arena.bump + CHUNK_SIZE;
+    }
+    void* result = arena.bump;
+    arena.bump += block;
+    return result;
+}
+
+void NumaArena::deallocate(void* ptr, std::size_t bytes, int node) {
+    if (!ptr) return;
+    if (node < 0 || node >= MAX_NODES) node = 0;
+    if (bytes > (std::size_t{ 1 } << MAX_CLASS_SHIFT)) {
+        VirtualFree(ptr, 0, MEM_RELEASE);
+        return;
+    }
+
+    NodeArena& arena = arenas[node];
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = arena.free_lists[sizeClass(bytes)];
+    arena.free_lists[sizeClass(bytes)] = block;
+}
@@ -0,0 +1,209 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : TimingWheel.cpp
+ * Description : Hierarchical timing wheel (O(1) schedule/cancel) and a
+                 locked wrapper that drives it from a single timer thread.
+ ****************************************************/
+
+#include "../include/TimingWheel.hpp"
+
+#include <algorithm>
+
+// TimingWheel
+
+TimingWheel::TimingWheel(std::chrono::milliseconds tick)
+    : tick(tick.count() > 0 ? tick : std::chrono::milliseconds(1)), origin(Clock::now()) {
+    heads.fill(NIL);
+}
+
+TimingWheel::TimerId TimingWheel::schedule(std::chrono::milliseconds delay, Callback cb) {
+    // Round up so a timer never fires before its delay has elapsed
+    long long millis = (std::max<long long>)(delay.count(), 0);
+    std::uint64_t ticks = static_cast<std::uint64_t>((millis + tick.count() - 1) / tick.count());
+    std::uint32_t index = allocNode();
+    Node& node = nodes[index];
+    node.expires = current_tick + (std::max)(ticks, std::uint64_t{ 1 });
+    node.callback = std::move(cb);
+    link(index);
+    ++active_count;
+    return (static_cast<TimerId>(node.generation) << 32) | index;
+}
+
+bool TimingWheel::cancel(TimerId id) {
+    std::uint32_t index = static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+    std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+    if (id == INVALID_TIMER || index >= nodes.size()) return false;
+
+    Node& node = nodes[index];
+    if (node.slot == NIL || node.generation != generation) return false;
+
+    unlink(index);
+    releaseNode(index);
+    --active_count;
+    return true;
+}
+
+void TimingWheel::advance(Clock::time_point now, std::vector<Callback>& expired) {
+    if (now < origin) return;
+    std::uint64_t target = static_cast<std::uint64_t>((now - origin) / tick);
+
+    while (current_tick <= target) {
+        // Nothing pending: jump straight to the present instead of ticking
+        if (active_count == 0) {
+            current_tick = target + 1;
+            break;
+        }
+        processTick(expired);
+    }
+}
+
+std::uint32_t TimingWheel::allocNode() {
+    if (!free_nodes.empty()) {
+        std::uint32_t index = free_nodes.back();
+        free_nodes.pop_back();
+        return index;
+    }
+    nodes.emplace_back();
+    return static_cast<std::uint32_t>(nodes.size() - 1);
+}
+
+void TimingWheel::releaseNode(std::uint32_t index) {
+    Node& node = nodes[index];
+    node.prev = node.next = node.slot = NIL;
+    node.callback = nullptr;
+    // Zero is reserved so that INVALID_TIMER never matches a live node
+    if (++node.generation == 0) node.generation = 1;
+    free_nodes.push_back(index);
+}
+
+// Places a node in the slot matching its distance from the current tick
+void TimingWheel::link(std::uint32_t index) {
+    Node& node = nodes[index];
+    std::uint64_t expires = node.expires;
+    std::uint32_t slot;
+
+    if (expires < current_tick) {
+        // Overdue (e.g. cascaded late): fire on the next processed tick
+        slot = static_cast<std::uint32_t>(current_tick & (ROOT_SIZE - 1));
+    }
+    else {
+        // Timers beyond the wheel's range park in the top level and are
+        // re-linked with their true expiry every time they cascade down
+        std::uint64_t delta = (std::min)(expires - current_tick, MAX_DELTA);
+        std::uint64_t placed = current_tick + delta;
+
+        if (delta < ROOT_SIZE) {
+            slot = static_cast<std::uint32_t>(placed & (ROOT_SIZE - 1));
+        }
+        else {
+            int level = 1;
+            while (level < LEVELS && delta >= (1ull << (ROOT_BITS + level * LEVEL_BITS))) ++level;
+            int shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+            slot = ROOT_SIZE + (level - 1) * LEVEL_SIZE
+                + static_cast<std::uint32_t>((placed >> shift) & (LEVEL_SIZE - 1));
+        }
+    }
+
+    node.slot = slot;
+    node.prev = NIL;
+    node.next = heads[slot];
+    if (node.next != NIL) nodes[node.next].prev = index;
+    heads[slot] = index;
+}
+
+void TimingWheel::unlink(std::uint32_t index) {
+    Node& node = nodes[index];
+    if (node.prev != NIL) nodes[node.prev].next = node.next;
+    else heads[node.slot] = node.next;
+    if (node.next != NIL) nodes[node.next].prev = node.prev;
+    node.prev = node.next = NIL;
+}
+
+// Re-distributes one slot of `level` into the levels below it and returns
+// the slot index, so the caller knows whether the next level wrapped too
+std::uint32_t TimingWheel::cascade(int level) {
+    int shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+    std::uint32_t index = static_cast<std::uint32_t>((current_tick >> shift) & (LEVEL_SIZE - 1));
+    std::uint32_t slot = ROOT_SIZE + (level - 1) * LEVEL_SIZE + index;
+
+    std::uint32_t cursor = heads[slot];
+    heads[slot] = NIL;
+    while (cursor != NIL) {
+        std::uint32_t next = nodes[cursor].next;
+        link(cursor);
+        cursor = next;
+    }
+    return index;
+}
+
+void TimingWheel::processTick(std::vector<Callback>& expired) {
+    std::uint32_t index = static_cast<std::uint32_t>(current_tick & (ROOT_SIZE - 1));
+    if (index == 0) {
+        for (int level = 1; level <= LEVELS; ++level) {
+            if (cascade(level) != 0) break;
+        }
+    }
+
+    std::uint32_t cursor = heads[index];
+    heads[index] = NIL;
+    ++current_tick;
+
+    while (cursor != NIL) {
+        std::uint32_t next = nodes[cursor].next;
+        expired.push_back(std::move(nodes[cursor].callback));
+        releaseNode(cursor);
+        --active_count;
+        cursor = next;
+    }
+}
+
+// TimerService
+
+TimerService::TimerService(std::chrono::milliseconds tick) : wheel(tick) {}
+
+TimerService::~TimerService() {
+    stop();
+}
+
+void TimerService::start() {
+    if (running.exchange(true)) return;
+    worker = std::thread(&TimerService::run, this);
+}
+
+void TimerService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running.exchange(false)) return;
+    }
+    stop_cv.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+TimingWheel::TimerId TimerService::schedule(std::chrono::milliseconds delay, TimingWheel::Callback cb) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return wheel.schedule(delay, std::move(cb));
+}
+
+bool TimerService::cancel(TimingWheel::TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return wheel.cancel(id);
+}
+
+void TimerService::run() {
+    std::vector<TimingWheel::Callback> expired;
+    while (running) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stop_cv.wait_for(lock, wheel.tickInterval(), [this] { return !running; });
+            if (!running) break;
+            wheel.advance(TimingWheel::Clock::now(), expired);
+        }
+
+        // Run callbacks unlocked so they can schedule follow-up timers
+        for (auto& callback : expired) {
+            if (callback) callback();
+        }
+        expired.clear();
+    }
+}
@@ -0,0 +1,131 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : TrafficCapture.cpp
+ * Description : Compact binary recording of inbound client sessions, and
+                 the reader tools/chat_replay uses to play them back
+ ****************************************************/
+
+#include "../include/TrafficCapture.hpp"
+
+#include <cstring>
+
+namespace {
+    const char MAGIC[8] = { 'C', 'H', 'A', 'T', 'C', 'A', 'P', '1' };
+    // Far above any single read; a larger length means a corrupt file
+    constexpr std::uint64_t MAX_RECORD = 1 << 24;
+
+    void putVarint(std::string& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+}
+
+namespace TrafficCapture {
+    bool Writer::open(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        start = std::chrono::steady_clock::now();
+        last_us = 0;
+        std::uint64_t wall_ms = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        out.write(MAGIC, sizeof(MAGIC));
+        for (int i = 0; i < 8; ++i) out.put(static_cast<char>(wall_ms >> (8 * i)));
+        return true;
+    }
+
+    Writer::~Writer() {
+        flush();
+    }
+
+    void Writer::login(std::uint32_t session, std::string_view username) {
+        append(Type::Login, session, username);
+    }
+
+    void Writer::line(std::uint32_t session, std::string_view data) {
+        append(Type::Line, session, data);
+    }
+
+    void Writer::close(std::uint32_t session) {
+        append(Type::Close, session, {});
+    }
+
+    // The timestamp is taken under the lock, so records are in time order
+    // and every delta is non-negative
+    void Writer::append(Type type, std::uint32_t session, std::string_view data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!out.is_open()) return;
+
+        std::uint64_t now_us = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        buffer += static_cast<char>(type);
+        putVarint(buffer, now_us - last_us);
+        putVarint(buffer, session);
+        if (type != Type::Close) {
+            putVarint(buffer, data.size());
+            buffer.append(data);
+        }
+        last_us = now_us;
+
+        if (buffer.size() >= FLUSH_BYTES) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+    void Writer::flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!out.is_open()) return;
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush();
+        buffer.clear();
+    }
+
+    bool Reader::open(const std::string& path) {
+        in.open(path, std::ios::binary);
+        char magic[sizeof(MAGIC)];
+        unsigned char wall[8];
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+            || !in.read(reinterpret_cast<char*>(wall), sizeof(wall)))
+            return false;
+
+        started_ms = 0;
+        for (int i = 7; i >= 0; --i) started_ms = (started_ms << 8) | wall[i];
+        now_us = 0;
+        return true;
+    }
+
+    bool Reader::readVarint(std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = in.get();
+            if (byte == EOF) return false;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool Reader::next(Record& record) {
+        int type = in.get();
+        std::uint64_t delta = 0, session = 0;
+        if (type == EOF || !readVarint(delta) || !readVarint(session)) return false;
+
+        record.type = static_cast<Type>(type);
+        now_us += delta;
+        record.at_us = now_us;
+        record.session = static_cast<std::uint32_t>(session);
+        record.data.clear();
+        if (record.type == Type::Close) return true;
+
+        std::uint64_t length = 0;
+        if (!readVarint(length) || length > MAX_RECORD) return false;
+        record.data.resize(static_cast<std::size_t>(length));
+        return static_cast<bool>(in.read(record.data.data(), static_cast<std::streamsize>(length)));
+    }
+}
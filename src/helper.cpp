@@ -7,9 +7,6 @@
 
 #include <iostream>
 
-#include "../include/TcpServer.hpp"
-#include "../include/TcpMultiServer.hpp"
-#include "../include/SelectServer.hpp"
 #include "../include/ClientAuthInc/server.hpp"
 
 class Helper {
@@ -17,33 +14,14 @@ public:
     Helper() = delete;
     ~Helper() = delete;
 
-    // Initializes a TCP server on port 8080 and starts it.
-    // Single-threaded (phase 2).
-    static void serverSingleThread() {
-        TcpServer server(8080);
-        server.start();
-    }
-
-
-	// Initializes a multithreaded TCP server on port 8080 and starts it.
-	// Multithreaded (phase 3).
-    static void serverMultiThread() {
-        TcpMultiServer server(8080);
-        server.start();
-	}
-
-	// Initializes a select-based server on port 8080 and starts it.
-	// (phase 4).
-    static void selectServer() {
-        SelectServer server;
-        server.run();
-	}
+    // The phase 2-4 servers are ChatServer instantiations now (see
+    // include/ChatServer.hpp); main starts those directly.
 
-    // Initializes a client authentication server on port 12345 and starts it.
+    // Initializes a client authentication server and starts it.
     // This server handles client connections and authentication.
 	// (phase 5).
-    static void clientAuthServer() {
-        Server server(12345);
+    static void clientAuthServer(int port, const ServerConfig& config = ServerConfig()) {
+        Server server(port, config);
         server.start();
         WSACleanup(); // Properly shuts down Winsock
     }
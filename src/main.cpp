@@ -6,12 +6,94 @@
  * Description : Defines the entry point for the application
  ****************************************************/
 
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 #include "helper.cpp"
+#include "../include/ChatServer.hpp"
 
-int main() {
-	Helper::selectServer();
+namespace {
+    template <typename ServerType>
+    void runChatServer(int port, const ServerConfig& config) {
+        ServerType server(port, config.network_cores);
+        server.start();
+    }
 
+    // Where each mode listens unless given a port: the phase 4 select
+    // server used 54000 and the auth server 12345, the others 8080
+    int defaultPort(const std::string& mode) {
+        if (mode == "select") return 54000;
+        if (mode == "auth") return 12345;
+        return 8080;
+    }
+
+    void usage() {
+        std::cerr << "Usage: multithreaded-chatserver [mode] [port] [--config FILE] [--<setting> VALUE ...]\n"
+                     "  single  echoes lines back to one client, then exits (phase 2)\n"
+                     "  multi   thread per client, answers \"You said: ...\" (phase 3)\n"
+                     "  select  one thread, select() loop, broadcast chat with login and idle timeouts (phase 4)\n"
+                     "  chunk   thread per client, one message per read, broadcast chat\n"
+                     "  auth    client authentication server (rooms, login, ...); not a ChatServer policy set\n"
+                     "Without a mode the select server runs. Default ports: select 54000, auth 12345, others 8080.\n"
+                     "Settings are ServerConfig fields (server_config.hpp), e.g. --credential_file users.txt\n"
+                     "--monitor_users alice,bob --network_cores 0,1 --busy_poll true; a config file holds\n"
+                     "one \"name = value\" per line, and later options override it. The auth server uses\n"
+                     "them all, the other modes only network_cores.\n";
+    }
+
+    // "--config FILE" and "--<setting> VALUE" pairs, in order
+    bool parseSettings(int argc, char* argv[], int first, ServerConfig& config) {
+        for (int i = first; i < argc; i += 2) {
+            std::string flag = argv[i];
+            if (flag.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+                std::cerr << "Expected --<setting> VALUE, got " << flag << "\n";
+                return false;
+            }
+            std::string name = flag.substr(2), value = argv[i + 1];
+            if (name == "config") {
+                std::string error;
+                if (!config.load(value, error)) {
+                    std::cerr << error << "\n";
+                    return false;
+                }
+            }
+            else if (!config.set(name, value)) {
+                std::cerr << "Unknown setting or bad value: " << flag << " " << value << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // The first four share ChatServer's connection handling and differ only
+    // in policies, so they can be benchmarked against each other like for
+    // like; auth is its own server
+    int next = 1;
+    std::string mode = next < argc && argv[next][0] != '-' ? argv[next++] : "select";
+    bool port_given = next < argc && argv[next][0] != '-';
+    int port = port_given ? std::atoi(argv[next++]) : defaultPort(mode);
+    ServerConfig config;
+    if (!parseSettings(argc, argv, next, config)) {
+        usage();
+        return 1;
+    }
+    try {
+        if (mode == "single") runChatServer<SingleClientChatServer>(port, config);
+        else if (mode == "multi") runChatServer<ThreadedChatServer>(port, config);
+        else if (mode == "select") runChatServer<SelectChatServer>(port, config);
+        else if (mode == "chunk") runChatServer<ChunkedChatServer>(port, config);
+        else if (mode == "auth") Helper::clientAuthServer(port, config);
+        else {
+            usage();
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
     return 0;
 }
@@ -0,0 +1,29 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : check.hpp
+ * Description : Minimal assertions shared by the unit tests
+ ****************************************************/
+
+#pragma once
+
+#include <iostream>
+
+// A failed CHECK prints where it failed and the test carries on; main
+// returns TestCheck::result() so ctest sees the failure
+namespace TestCheck {
+    inline int failures = 0;
+
+    inline int result() {
+        if (failures > 0) std::cerr << failures << " check(s) failed\n";
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) {                                                               \
+            ++TestCheck::failures;                                                        \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+        }                                                                                 \
+    } while (0)
@@ -0,0 +1,101 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : compression_test.cpp
+ * Description : Round trip of a connection stream mixing its own output,
+                 spliced shared frames and stored blocks
+ ****************************************************/
+
+#include "check.hpp"
+#include "../include/ClientAuthInc/compression.hpp"
+
+#include <zlib.h>
+
+namespace {
+    // The client side: one raw inflate stream for the whole connection
+    class Inflater {
+    public:
+        explicit Inflater(int window_bits) { ok = inflateInit2(&stream, -window_bits) == Z_OK; }
+        ~Inflater() { inflateEnd(&stream); }
+
+        bool ok = false;
+
+        std::string feed(const std::string& bytes) {
+            std::string text;
+            char buffer[4096];
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(bytes.data()));
+            stream.avail_in = static_cast<uInt>(bytes.size());
+            do {
+                stream.next_out = reinterpret_cast<Bytef*>(buffer);
+                stream.avail_out = sizeof(buffer);
+                int status = inflate(&stream, Z_SYNC_FLUSH);
+                if (status != Z_OK && status != Z_BUF_ERROR) {
+                    ok = false;
+                    break;
+                }
+                text.append(buffer, sizeof(buffer) - stream.avail_out);
+            } while (stream.avail_out == 0);
+            return text;
+        }
+
+    private:
+        z_stream stream{};
+    };
+
+    ServerConfig settings() {
+        ServerConfig config;
+        config.compression = true;
+        config.compression_window_bits = 12;
+        return config;
+    }
+
+    // Later lines repeat earlier ones, so a window that fell out of step
+    // with the client's after a splice would decode to the wrong text
+    void splicedFrames() {
+        Compression::configure(settings());
+        CHECK(Compression::available());
+        Compression::RoomStats stats;
+        Compression::Stream stream;
+        Inflater client(Compression::windowBits());
+        CHECK(stream.ok() && client.ok);
+
+        const std::string own = "Welcome to lobby, alice!\n";
+        const std::string shared = "bob: hello hello hello everyone in the lobby\n";
+        const std::string stored = "carol: hello from a room that is not compressed\n";
+        const std::string again = "bob: hello hello hello everyone in the lobby, alice!\n";
+
+        stream.compress(own);
+        auto frame = Compression::sharedFrame(shared, stats, 2);
+        CHECK(frame && !frame->empty());
+        stream.insert(*frame, shared);
+        stream.compress(again);
+        CHECK(client.feed(stream.take()) == own + shared + again);
+
+        stream.store(stored);
+        stream.compress(again + stored);
+        // The same frame spliced a second time, as for another member
+        stream.insert(*frame, shared);
+        stream.compress(again);
+        CHECK(client.feed(stream.take()) == stored + again + stored + shared + again);
+        CHECK(client.ok);
+    }
+
+    // Frames come from pooled encoders that are reset between messages;
+    // each must decode on its own from a fresh window
+    void independentFrames() {
+        Compression::configure(settings());
+        Compression::RoomStats stats;
+        for (int i = 0; i < 8; ++i) {
+            std::string text = "message " + std::to_string(i) + ": " + std::string(static_cast<std::size_t>(i) * 10, 'x') + "\n";
+            auto frame = Compression::sharedFrame(text, stats, 1);
+            Inflater client(Compression::windowBits());
+            CHECK(frame && client.feed(*frame) == text);
+        }
+    }
+}
+
+int main() {
+    splicedFrames();
+    independentFrames();
+    return TestCheck::result();
+}
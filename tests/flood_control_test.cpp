@@ -0,0 +1,90 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : flood_control_test.cpp
+ * Description : FloodControl token-bucket verdicts
+ ****************************************************/
+
+#include "check.hpp"
+#include "../include/ClientAuthInc/flood_control.hpp"
+
+namespace {
+    using Action = FloodControl::Action;
+
+    // Every budget off; each test turns on the ones it needs
+    ServerConfig unlimited() {
+        ServerConfig config;
+        config.flood_client_msgs_per_sec = 0;
+        config.flood_client_bytes_per_sec = 0;
+        config.flood_room_msgs_per_sec = 0;
+        config.flood_room_bytes_per_sec = 0;
+        return config;
+    }
+
+    void disabled() {
+        FloodControl flood(unlimited());
+        FloodControl::Budget client;
+        CHECK(!flood.enabled());
+        for (int i = 0; i < 100; ++i) CHECK(flood.check(client, "lobby", 1000).action == Action::Pass);
+    }
+
+    // Burst, then a delay while the overdraft is within flood_max_delay,
+    // then drops, then a disconnect once the strikes add up
+    void clientBudget() {
+        ServerConfig config = unlimited();
+        config.flood_client_msgs_per_sec = 1.0;
+        config.flood_client_msg_burst = 2.0;
+        config.flood_max_delay = std::chrono::milliseconds(1000);
+        config.flood_disconnect_strikes = 2;
+        FloodControl flood(config);
+        FloodControl::Budget client;
+
+        CHECK(flood.check(client, "lobby", 10).action == Action::Pass);
+        CHECK(flood.check(client, "lobby", 10).action == Action::Pass);
+        FloodControl::Verdict delayed = flood.check(client, "lobby", 10);
+        CHECK(delayed.action == Action::Delay);
+        CHECK(delayed.delay.count() > 900 && delayed.delay.count() <= 1001);
+        CHECK(flood.check(client, "lobby", 10).action == Action::Drop);
+        CHECK(flood.check(client, "lobby", 10).action == Action::Disconnect);
+    }
+
+    // A line longer than the byte burst is charged the burst, so it passes
+    // on a full bucket
+    void oversizedLine() {
+        ServerConfig config = unlimited();
+        config.flood_client_bytes_per_sec = 100.0;
+        config.flood_client_byte_burst = 100.0;
+        config.flood_max_delay = std::chrono::milliseconds(0);
+        FloodControl flood(config);
+        FloodControl::Budget client;
+
+        CHECK(flood.check(client, "lobby", 5000).action == Action::Pass);
+        CHECK(flood.check(client, "lobby", 50).action == Action::Drop);
+    }
+
+    // A full room drops lines but strikes no one
+    void roomBudget() {
+        ServerConfig config = unlimited();
+        config.flood_room_msgs_per_sec = 1.0;
+        config.flood_room_msg_burst = 1.0;
+        config.flood_max_delay = std::chrono::milliseconds(0);
+        config.flood_disconnect_strikes = 1;
+        FloodControl flood(config);
+        FloodControl::Budget first, second;
+
+        CHECK(flood.check(first, "lobby", 10).action == Action::Pass);
+        CHECK(flood.check(second, "lobby", 10).action == Action::Drop);
+        CHECK(flood.check(second, "lobby", 10).action == Action::Drop);
+        CHECK(second.strikes == 0);
+        // Other rooms have their own budget
+        CHECK(flood.check(second, "support", 10).action == Action::Pass);
+    }
+}
+
+int main() {
+    disabled();
+    clientBudget();
+    oversizedLine();
+    roomBudget();
+    return TestCheck::result();
+}
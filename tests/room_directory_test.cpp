@@ -0,0 +1,79 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : room_directory_test.cpp
+ * Description : RoomDirectory paging and prefix queries
+ ****************************************************/
+
+#include "check.hpp"
+#include "../include/ClientAuthInc/room_directory.hpp"
+
+namespace {
+    bool contains(const std::string& text, const std::string& part) {
+        return text.find(part) != std::string::npos;
+    }
+
+    // Two rooms a page, and no refresh delay so every change shows at once
+    void fill(RoomDirectory& directory) {
+        ServerConfig config;
+        config.rooms_page_size = 2;
+        config.rooms_refresh = std::chrono::milliseconds(0);
+        directory.configure(config);
+        directory.update("support.eu", 3);
+        directory.update("lobby", 5);
+        directory.update("support.us", 1);
+        directory.update("sales", 2);
+    }
+
+    void paging() {
+        RoomDirectory directory;
+        fill(directory);
+
+        std::string first = directory.query("", 1);
+        CHECK(contains(first, "Active rooms (4, page 1/2):\n"));
+        CHECK(contains(first, "- lobby (5 users)\n- sales (2 users)\n"));
+        CHECK(contains(first, "More: /rooms 2\n"));
+
+        std::string second = directory.query("", 2);
+        CHECK(contains(second, "- support.eu (3 users)\n- support.us (1 users)\n"));
+        CHECK(!contains(second, "More:"));
+
+        CHECK(directory.query("", 3) == "No such page (2 in total).\n");
+    }
+
+    void prefixes() {
+        RoomDirectory directory;
+        fill(directory);
+
+        std::string support = directory.query("support.", 1);
+        CHECK(contains(support, "starting with 'support.' (2, page 1/1)"));
+        CHECK(contains(support, "- support.eu") && contains(support, "- support.us"));
+        CHECK(!contains(support, "lobby") && !contains(support, "sales"));
+
+        // "s" covers sales and both support rooms, so it needs a second page
+        std::string s = directory.query("s", 1);
+        CHECK(contains(s, "(3, page 1/2)"));
+        CHECK(contains(s, "More: /rooms s 2\n"));
+
+        CHECK(contains(directory.query("zzz", 1), "(0, page 1/1)"));
+    }
+
+    void updates() {
+        RoomDirectory directory;
+        fill(directory);
+        CHECK(contains(directory.query("", 1), "- lobby (5 users)"));
+
+        directory.update("lobby", 6);
+        directory.remove("sales");
+        std::string first = directory.query("", 1);
+        CHECK(contains(first, "(3, page 1/2)"));
+        CHECK(contains(first, "- lobby (6 users)\n- support.eu (3 users)\n"));
+    }
+}
+
+int main() {
+    paging();
+    prefixes();
+    updates();
+    return TestCheck::result();
+}
@@ -0,0 +1,83 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : subscription_trie_test.cpp
+ * Description : SubscriptionTrie pattern matching and removal
+ ****************************************************/
+
+#include "check.hpp"
+#include "../include/ClientAuthInc/subscription_trie.hpp"
+
+#include <algorithm>
+
+namespace {
+    std::vector<int> matching(const SubscriptionTrie& trie, std::string_view room) {
+        std::vector<int> out;
+        trie.match(room, out);
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    void patterns() {
+        CHECK(SubscriptionTrie::validPattern("support.*"));
+        CHECK(SubscriptionTrie::validPattern("*"));
+        CHECK(SubscriptionTrie::validPattern("*.billing"));
+        CHECK(!SubscriptionTrie::validPattern(""));
+        CHECK(!SubscriptionTrie::validPattern("support..billing"));
+    }
+
+    void matches() {
+        SubscriptionTrie trie;
+        CHECK(trie.add("support.*", 1));
+        CHECK(trie.add("*", 2));
+        CHECK(trie.add("*.billing", 3));
+        CHECK(trie.add("sales", 4));
+        CHECK(!trie.add("sales", 4));
+        CHECK(trie.size() == 4);
+
+        // A trailing '*' takes one or more segments, an inner one exactly one
+        CHECK(matching(trie, "support.billing") == std::vector<int>({ 1, 2, 3 }));
+        CHECK(matching(trie, "support.eu.billing") == std::vector<int>({ 1, 2 }));
+        CHECK(matching(trie, "support") == std::vector<int>({ 2 }));
+        CHECK(matching(trie, "sales") == std::vector<int>({ 2, 4 }));
+        CHECK(matching(trie, "sales.billing") == std::vector<int>({ 2, 3 }));
+    }
+
+    void subscriberMatchedOnce() {
+        SubscriptionTrie trie;
+        trie.add("support.*", 7);
+        trie.add("*", 7);
+        trie.add("support.billing", 7);
+        CHECK(matching(trie, "support.billing") == std::vector<int>({ 7 }));
+    }
+
+    void removal() {
+        SubscriptionTrie trie;
+        trie.add("support.*", 1);
+        trie.add("support.*", 2);
+        trie.add("support.billing", 3);
+
+        CHECK(trie.remove("support.*", 1));
+        CHECK(!trie.remove("support.*", 1));
+        CHECK(!trie.remove("support.eu", 2));
+        CHECK(trie.size() == 2);
+        CHECK(matching(trie, "support.billing") == std::vector<int>({ 2, 3 }));
+
+        CHECK(trie.remove("support.*", 2));
+        CHECK(trie.remove("support.billing", 3));
+        CHECK(trie.size() == 0);
+        CHECK(matching(trie, "support.billing").empty());
+
+        // Pruned branches can be subscribed to again
+        CHECK(trie.add("support.*", 1));
+        CHECK(matching(trie, "support.eu") == std::vector<int>({ 1 }));
+    }
+}
+
+int main() {
+    patterns();
+    matches();
+    subscriberMatchedOnce();
+    removal();
+    return TestCheck::result();
+}
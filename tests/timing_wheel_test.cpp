@@ -0,0 +1,105 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : timing_wheel_test.cpp
+ * Description : TimingWheel expiry, cascading between levels and cancel
+ ****************************************************/
+
+#include "check.hpp"
+#include "../include/TimingWheel.hpp"
+
+#include <string>
+
+namespace {
+    using namespace std::chrono_literals;
+
+    // The wheel's origin is taken in its constructor, somewhere between
+    // `before` and `after`; stepping from `before` never runs ahead of it,
+    // stepping from `after` never lags behind
+    struct Fixture {
+        TimingWheel::Clock::time_point before = TimingWheel::Clock::now();
+        TimingWheel wheel{ 1ms };
+        TimingWheel::Clock::time_point after = TimingWheel::Clock::now();
+        std::string fired;
+
+        TimingWheel::TimerId at(std::chrono::milliseconds delay, char name) {
+            return wheel.schedule(delay, [this, name] { fired += name; });
+        }
+
+        void advance(TimingWheel::Clock::time_point now) {
+            std::vector<TimingWheel::Callback> expired;
+            wheel.advance(now, expired);
+            for (auto& callback : expired) callback();
+        }
+    };
+
+    void expiry() {
+        Fixture f;
+        f.at(5ms, 'a');
+        f.at(0ms, 'b');     // at least one tick
+        f.advance(f.before);
+        CHECK(f.fired.empty());
+        f.advance(f.after + 2ms);
+        CHECK(f.fired == "b");
+        f.advance(f.after + 6ms);
+        CHECK(f.fired == "ba");
+        CHECK(f.wheel.size() == 0);
+    }
+
+    // Delays past the 256-tick root wheel sit on higher levels and must
+    // cascade down to fire on time, in order
+    void cascade() {
+        Fixture f;
+        f.at(300ms, 'a');           // level 1
+        f.at(20000ms, 'b');         // level 2
+        f.at(1100000ms, 'c');       // level 3
+        f.at(257ms, 'd');           // just past the root wheel
+        CHECK(f.wheel.size() == 4);
+
+        f.advance(f.before + 250ms);
+        CHECK(f.fired.empty());
+        f.advance(f.after + 258ms);
+        CHECK(f.fired == "d");
+        f.advance(f.before + 299ms);
+        CHECK(f.fired == "d");
+        f.advance(f.after + 301ms);
+        CHECK(f.fired == "da");
+        f.advance(f.before + 19990ms);
+        CHECK(f.fired == "da");
+        f.advance(f.after + 20001ms);
+        CHECK(f.fired == "dab");
+        f.advance(f.before + 1099990ms);
+        CHECK(f.fired == "dab");
+        f.advance(f.after + 1100001ms);
+        CHECK(f.fired == "dabc");
+    }
+
+    void cancel() {
+        Fixture f;
+        TimingWheel::TimerId near = f.at(10ms, 'a');
+        TimingWheel::TimerId far = f.at(5000ms, 'b');
+        f.at(20ms, 'c');
+
+        CHECK(f.wheel.cancel(near));
+        CHECK(!f.wheel.cancel(near));
+        CHECK(f.wheel.cancel(far));
+        CHECK(!f.wheel.cancel(TimingWheel::INVALID_TIMER));
+        CHECK(f.wheel.size() == 1);
+
+        // A stale id must not cancel the timer that reused its node
+        TimingWheel::TimerId reused = f.at(30ms, 'd');
+        CHECK(!f.wheel.cancel(near));
+        CHECK(!f.wheel.cancel(far));
+
+        f.advance(f.after + 6000ms);
+        CHECK(f.fired == "cd");
+        CHECK(!f.wheel.cancel(reused));
+    }
+}
+
+int main() {
+    expiry();
+    cascade();
+    cancel();
+    return TestCheck::result();
+}
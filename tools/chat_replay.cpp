@@ -0,0 +1,394 @@
+/****************************************************
+ * Author      : Phyu H. Lwin
+ * Date        : 2026 October 19
+ * Filename    : chat_replay.cpp
+ * Description : Re-drives a traffic capture against a running server and
+                 reports throughput and delivery latency
+ ****************************************************/
+
+#include "../include/TrafficCapture.hpp"
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string capture;
+        std::string host = "127.0.0.1";
+        int port = 12345;
+        double speed = 1.0;             // 0 = as fast as possible
+        std::string password;           // answered whenever the server asks, same for every user
+        std::string login = "welcome";  // welcome | prompt | none
+        std::string report_file;
+        std::string baseline_file;
+    };
+
+    struct Event {
+        std::uint64_t at_us;
+        bool close;
+        std::string data;
+    };
+
+    struct Session {
+        std::string username;
+        std::uint64_t login_us = 0;
+        std::vector<Event> events;
+
+        // Filled in by the replay
+        std::vector<double> latencies_ms;
+        bool logged_in = false;
+    };
+
+    // Each user's room lines in the order sent, numbered from `first`. A
+    // room delivers one sender's lines in order, so a receiver matches a
+    // line against that sender's log from just after its previous match;
+    // repeated lines then pair with their own send. Entries older than
+    // SENT_HORIZON are dropped, and a late arrival goes unmeasured.
+    constexpr std::chrono::seconds SENT_HORIZON{ 60 };
+
+    struct SentLog {
+        std::uint64_t first = 0;
+        std::deque<std::pair<std::string, Clock::time_point>> lines;
+    };
+    std::mutex sent_mutex;
+    std::unordered_map<std::string, SentLog> sent_by_user;
+
+    std::atomic<std::uint64_t> lines_sent{ 0 };
+    std::atomic<std::uint64_t> messages_received{ 0 };
+
+    void usage() {
+        std::cerr << "Usage: chat-replay <capture> [--host H] [--port P] [--speed N|max]\n"
+                     "                   [--login welcome|prompt|none] [--password PW]\n"
+                     "                   [--report FILE] [--baseline FILE]\n"
+                     "  --login    welcome: send the name, wait for a \"Welcome\" line (default)\n"
+                     "             prompt:  send the name, logged in straight away (no welcome sent)\n"
+                     "             none:    send nothing, logged in on connect (echo servers)\n"
+                     "  --password one password answered for every replayed user\n";
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        if (argc < 2) return false;
+        options.capture = argv[1];
+        for (int i = 2; i + 1 < argc; i += 2) {
+            std::string flag = argv[i], value = argv[i + 1];
+            if (flag == "--host") options.host = value;
+            else if (flag == "--port") options.port = std::stoi(value);
+            else if (flag == "--speed") options.speed = value == "max" ? 0.0 : std::stod(value);
+            else if (flag == "--login") options.login = value;
+            else if (flag == "--password") options.password = value;
+            else if (flag == "--report") options.report_file = value;
+            else if (flag == "--baseline") options.baseline_file = value;
+            else return false;
+        }
+        bool known_login = options.login == "welcome" || options.login == "prompt" || options.login == "none";
+        return (argc % 2) == 0 && options.speed >= 0.0 && known_login;
+    }
+
+    bool loadCapture(const std::string& path, std::vector<Session>& sessions) {
+        TrafficCapture::Reader reader;
+        if (!reader.open(path)) return false;
+
+        std::unordered_map<std::uint32_t, std::size_t> index;
+        TrafficCapture::Record record;
+        while (reader.next(record)) {
+            if (record.type == TrafficCapture::Type::Login) {
+                index[record.session] = sessions.size();
+                sessions.push_back({ record.data, record.at_us, {}, {}, false });
+                continue;
+            }
+            auto it = index.find(record.session);
+            if (it == index.end()) continue;
+            sessions[it->second].events.push_back({ record.at_us, record.type == TrafficCapture::Type::Close,
+                std::move(record.data) });
+        }
+        return true;
+    }
+
+    std::string trimmed(std::string text) {
+        text.erase(text.find_last_not_of(" \t\r\n") + 1);
+        return text;
+    }
+
+    // Strips the optional "#<seq> " and "[room] " prefixes of a room line
+    std::string messageKey(const std::string& line) {
+        std::size_t start = 0;
+        if (line.size() > 1 && line[0] == '#') {
+            std::size_t space = line.find(' ');
+            if (space != std::string::npos) start = space + 1;
+        }
+        if (start < line.size() && line[start] == '[') {
+            std::size_t close = line.find("] ", start);
+            if (close != std::string::npos) start = close + 2;
+        }
+        return line.substr(start);
+    }
+
+    class Connection {
+    public:
+        Connection(Session& session, const Options& options) : session(session), options(options) {}
+
+        bool connectTo(const sockaddr_in& address) {
+            socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (socket_fd == INVALID_SOCKET) return false;
+            if (connect(socket_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR) {
+                closesocket(socket_fd);
+                socket_fd = INVALID_SOCKET;
+                return false;
+            }
+            reader = std::thread([this] { readLoop(); });
+            return true;
+        }
+
+        // Sends the username and waits for the welcome (or a refusal); with
+        // --login prompt or none the server sends no welcome to wait for
+        bool login() {
+            if (options.login != "none") sendText(session.username + "\n");
+            std::unique_lock<std::mutex> lock(mutex);
+            if (options.login != "welcome") welcomed = !refused;
+            cv.wait_for(lock, std::chrono::seconds(10), [this] { return welcomed || refused; });
+            return welcomed;
+        }
+
+        void sendText(const std::string& text) {
+            send(socket_fd, text.c_str(), static_cast<int>(text.size()), 0);
+        }
+
+        void finish() {
+            if (socket_fd == INVALID_SOCKET) return;
+            shutdown(socket_fd, SD_BOTH);
+            if (reader.joinable()) reader.join();
+            closesocket(socket_fd);
+            socket_fd = INVALID_SOCKET;
+        }
+
+        ~Connection() { finish(); }
+
+    private:
+        Session& session;
+        const Options& options;
+        SOCKET socket_fd = INVALID_SOCKET;
+        std::thread reader;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool welcomed = false;
+        bool refused = false;
+
+        // Per sender, the log position after the last line matched; reader thread only
+        std::unordered_map<std::string, std::uint64_t> next_from;
+
+        void readLoop() {
+            char buffer[4096];
+            std::string pending;
+            while (true) {
+                int len = recv(socket_fd, buffer, sizeof(buffer), 0);
+                if (len <= 0) break;
+                Clock::time_point now = Clock::now();
+                pending.append(buffer, len);
+
+                std::size_t newline;
+                while ((newline = pending.find('\n')) != std::string::npos) {
+                    onLine(trimmed(pending.substr(0, newline)), now);
+                    pending.erase(0, newline + 1);
+                }
+                // Prompts come without a line ending
+                if (pending.size() >= 10 && pending.compare(pending.size() - 10, 10, "Password: ") == 0) {
+                    sendText(options.password + "\n");
+                    pending.clear();
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            refused = !welcomed;
+            cv.notify_all();
+        }
+
+        void onLine(const std::string& line, Clock::time_point now) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!welcomed) {
+                    if (line.find("Welcome") != std::string::npos) welcomed = true;
+                    else if (line.find("taken") != std::string::npos || line.find("Invalid") != std::string::npos) refused = true;
+                    cv.notify_all();
+                    return;
+                }
+            }
+
+            // "<user>: <text>"; usernames contain no spaces
+            std::string key = messageKey(line);
+            std::size_t colon = key.find(": ");
+            if (colon == std::string::npos || key.find(' ') < colon) return;
+            std::string sender = key.substr(0, colon), text = key.substr(colon + 2);
+
+            Clock::time_point sent;
+            {
+                std::lock_guard<std::mutex> lock(sent_mutex);
+                auto it = sent_by_user.find(sender);
+                if (it == sent_by_user.end()) return;
+                const SentLog& log = it->second;
+                std::uint64_t& next = next_from[sender];
+                std::uint64_t i = (std::max)(next, log.first);
+                while (i < log.first + log.lines.size() && log.lines[i - log.first].first != text) ++i;
+                if (i == log.first + log.lines.size()) return;
+                sent = log.lines[i - log.first].second;
+                next = i + 1;
+            }
+            messages_received.fetch_add(1, std::memory_order_relaxed);
+            if (now >= sent)
+                session.latencies_ms.push_back(std::chrono::duration<double, std::milli>(now - sent).count());
+        }
+    };
+
+    Clock::time_point due(Clock::time_point origin, std::uint64_t at_us, double speed) {
+        if (speed <= 0.0) return origin;
+        return origin + std::chrono::microseconds(static_cast<std::int64_t>(static_cast<double>(at_us) / speed));
+    }
+
+    void replaySession(Session& session, const Options& options, const sockaddr_in& address,
+        Clock::time_point origin) {
+        std::this_thread::sleep_until(due(origin, session.login_us, options.speed));
+        Connection connection(session, options);
+        if (!connection.connectTo(address) || !connection.login()) return;
+        session.logged_in = true;
+
+        for (const Event& event : session.events) {
+            std::this_thread::sleep_until(due(origin, event.at_us, options.speed));
+            if (event.close) break;
+
+            std::string line = trimmed(event.data);
+            if (!line.empty() && line[0] != '/') {
+                Clock::time_point now = Clock::now();
+                std::lock_guard<std::mutex> lock(sent_mutex);
+                SentLog& log = sent_by_user[session.username];
+                while (!log.lines.empty() && now - log.lines.front().second > SENT_HORIZON) {
+                    log.lines.pop_front();
+                    ++log.first;
+                }
+                log.lines.emplace_back(line, now);
+            }
+            connection.sendText(event.data.ends_with("\n") ? event.data : event.data + "\n");
+            lines_sent.fetch_add(1, std::memory_order_relaxed);
+        }
+        // Leave time for the last broadcasts to arrive before hanging up
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        connection.finish();
+    }
+
+    double percentile(std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        std::size_t rank = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[rank];
+    }
+
+    std::map<std::string, double> readReport(const std::string& path) {
+        std::map<std::string, double> values;
+        std::ifstream in(path);
+        std::string key;
+        double value;
+        while (in >> key >> value) values[key] = value;
+        return values;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    std::vector<Session> sessions;
+    if (!loadCapture(options.capture, sessions)) {
+        std::cerr << "Not a capture file: " << options.capture << std::endl;
+        return 1;
+    }
+
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        std::cerr << "WSAStartup failed" << std::endl;
+        return 1;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<u_short>(options.port));
+    if (inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "Bad host address: " << options.host << std::endl;
+        return 1;
+    }
+
+    std::cout << "Replaying " << sessions.size() << " sessions at "
+              << (options.speed > 0.0 ? std::to_string(options.speed) + "x" : std::string("max speed")) << std::endl;
+
+    // Every session gets its own thread, as on the server; a short head
+    // start lets them all be created before the first one is due
+    Clock::time_point origin = Clock::now() + std::chrono::milliseconds(500);
+    std::vector<std::thread> threads;
+    threads.reserve(sessions.size());
+    for (Session& session : sessions)
+        threads.emplace_back([&session, &options, &address, origin] { replaySession(session, options, address, origin); });
+    for (auto& thread : threads) thread.join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - origin).count();
+    WSACleanup();
+
+    std::vector<double> latencies;
+    std::size_t logged_in = 0;
+    for (const Session& session : sessions) {
+        latencies.insert(latencies.end(), session.latencies_ms.begin(), session.latencies_ms.end());
+        if (session.logged_in) ++logged_in;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::map<std::string, double> results;
+    results["sessions"] = static_cast<double>(sessions.size());
+    results["logins_failed"] = static_cast<double>(sessions.size() - logged_in);
+    results["seconds"] = elapsed;
+    results["lines_sent"] = static_cast<double>(lines_sent.load());
+    results["messages_received"] = static_cast<double>(messages_received.load());
+    results["lines_per_sec"] = elapsed > 0 ? results["lines_sent"] / elapsed : 0.0;
+    results["deliveries_per_sec"] = elapsed > 0 ? results["messages_received"] / elapsed : 0.0;
+    results["latency_p50_ms"] = percentile(latencies, 0.50);
+    results["latency_p90_ms"] = percentile(latencies, 0.90);
+    results["latency_p99_ms"] = percentile(latencies, 0.99);
+    results["latency_max_ms"] = latencies.empty() ? 0.0 : latencies.back();
+
+    // Against a baseline, each value is shown with its change
+    std::map<std::string, double> baseline;
+    if (!options.baseline_file.empty()) baseline = readReport(options.baseline_file);
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& [key, value] : results) {
+        std::cout << std::left << std::setw(20) << key << std::right << std::setw(14) << value;
+        auto it = baseline.find(key);
+        if (it != baseline.end()) {
+            std::cout << "   was " << std::setw(12) << it->second;
+            if (it->second != 0.0)
+                std::cout << "  (" << std::showpos << (value - it->second) / it->second * 100.0 << std::noshowpos << "%)";
+        }
+        std::cout << "\n";
+    }
+
+    if (!options.report_file.empty()) {
+        std::ofstream out(options.report_file);
+        out << std::setprecision(6);
+        for (const auto& [key, value] : results) out << key << " " << value << "\n";
+    }
+    return 0;
+}